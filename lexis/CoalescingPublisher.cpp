@@ -0,0 +1,49 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#include "CoalescingPublisher.h"
+
+#include <lexis/detail/PeriodicThread.h>
+
+#include <vector>
+
+namespace lexis
+{
+CoalescingPublisher::CoalescingPublisher( const PublishFunc& publish,
+                                          const std::chrono::milliseconds interval )
+    : _publish( publish )
+    , _flusher( new detail::PeriodicThread( [this] { flush(); }, interval ))
+{
+}
+
+CoalescingPublisher::~CoalescingPublisher()
+{
+    _flusher.reset();
+    flush();
+}
+
+void CoalescingPublisher::flush()
+{
+    std::lock_guard< std::mutex > flushLock( _flushMutex );
+
+    // swap the pending events out under the lock, publish without it
+    std::vector< const servus::Serializable* > events;
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        for( auto& i : _slots )
+        {
+            Slot& slot = i.second;
+            if( !slot.dirty )
+                continue;
+            std::swap( slot.pending, slot.sending );
+            slot.dirty = false;
+            events.push_back( slot.sending.get( ));
+        }
+    }
+
+    for( const auto* event : events )
+        _publish( *event );
+}
+
+}
@@ -0,0 +1,113 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#pragma once
+
+#include <lexis/api.h>
+#include <lexis/types.h>
+#include <servus/serializable.h> // used inline
+#include <servus/uint128_t.h>
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <typeinfo>
+
+namespace lexis
+{
+namespace detail { class PeriodicThread; }
+
+/**
+ * Rate-limiting wrapper for publishing state-like events.
+ *
+ * Events of the same type replace each other until they are flushed, so only
+ * the latest value of each type is published at most once per interval, while
+ * the most recent value is never dropped. Meant for events describing a state,
+ * e.g. render::LookOut, render::Frame, render::Viewport, render::ClipPlanes or
+ * data::Progress, not for events where every instance matters.
+ *
+ * The publish function is called from the flush thread of the coalescer and
+ * from flush(). As zeroeq::Publisher is not thread safe, it has to be
+ * dedicated to the coalescer or all its uses have to be synchronized.
+ *
+ * Example:
+ * @code
+ * std::mutex mutex; // guards all uses of publisher
+ * zeroeq::Publisher publisher;
+ * lexis::CoalescingPublisher coalescer(
+ *     [&]( const servus::Serializable& event )
+ *     {
+ *         std::lock_guard< std::mutex > lock( mutex );
+ *         return publisher.publish( event );
+ *     },
+ *     std::chrono::milliseconds( 20 ));
+ *
+ * coalescer.publish( lookOut ); // on every mouse move
+ *
+ * std::lock_guard< std::mutex > lock( mutex );
+ * publisher.publish( image ); // every image matters, publish directly
+ * @endcode
+ */
+class CoalescingPublisher
+{
+public:
+    using PublishFunc = lexis::PublishFunc;
+
+    /**
+     * Start the flush thread.
+     *
+     * @param publish called from the flush thread for each pending event,
+     *                synchronized with other uses of its publisher
+     * @param interval the time between two flushes
+     */
+    LEXIS_API CoalescingPublisher( const PublishFunc& publish,
+                                   std::chrono::milliseconds interval );
+
+    /** Flush all pending events and stop the flush thread. */
+    LEXIS_API ~CoalescingPublisher();
+
+    /**
+     * Schedule an event for publishing, replacing any pending event of the
+     * same type. Thread safe.
+     *
+     * Only the first events of a type allocate memory, later ones are copied
+     * into the storage of their predecessors. Events of different classes
+     * sharing a type identifier, e.g. render::ClipPlanes and its generated
+     * base class, replace each other but not their storage.
+     */
+    template< class T > void publish( const T& event )
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        Slot& slot = _slots[ event.getTypeIdentifier() ];
+        if( slot.pending && typeid( *slot.pending ) == typeid( T ))
+            static_cast< T& >( *slot.pending ) = event;
+        else
+            slot.pending.reset( new T( event ));
+        slot.dirty = true;
+    }
+
+    /** Publish all pending events now. Thread safe. */
+    LEXIS_API void flush();
+
+private:
+    CoalescingPublisher( const CoalescingPublisher& ) = delete;
+    CoalescingPublisher& operator=( const CoalescingPublisher& ) = delete;
+
+    struct Slot
+    {
+        std::unique_ptr< servus::Serializable > pending;
+        std::unique_ptr< servus::Serializable > sending;
+        bool dirty = false;
+    };
+
+    const PublishFunc _publish;
+
+    std::mutex _mutex; // protects _slots
+    std::map< servus::uint128_t, Slot > _slots;
+
+    std::mutex _flushMutex; // serializes flush()
+    std::unique_ptr< detail::PeriodicThread > _flusher;
+};
+}
@@ -0,0 +1,111 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#include "Envelope.h"
+
+#include <cstring>
+
+namespace lexis
+{
+void Envelope::add( const servus::Serializable& event )
+{
+    add( std::vector< const servus::Serializable* >{ &event });
+}
+
+void Envelope::add( const std::vector< const servus::Serializable* >& events )
+{
+    if( events.empty( ))
+        return;
+
+    std::vector< servus::Serializable::Data > binaries;
+    binaries.reserve( events.size( ));
+    size_t size = 0;
+    for( const auto* event : events )
+    {
+        binaries.push_back( event->toBinary( ));
+        size += binaries.back().size;
+    }
+
+    const size_t nEvents = getNumEvents();
+    auto& types = getTypes();
+    auto& offsets = getOffsets();
+    auto& data = getData();
+    size_t offset = data.size();
+    types.resize( 2 * ( nEvents + events.size( )));
+    offsets.resize( nEvents + events.size( ));
+    data.resize( offset + size );
+
+    uint64_t* typeData = types.data() + 2 * nEvents;
+    uint64_t* offsetData = offsets.data() + nEvents;
+    for( size_t i = 0; i < events.size(); ++i )
+    {
+        const servus::uint128_t type = events[i]->getTypeIdentifier();
+        const servus::Serializable::Data& binary = binaries[i];
+        typeData[ 2 * i ] = type.high();
+        typeData[ 2 * i + 1 ] = type.low();
+        if( binary.size > 0 )
+            ::memcpy( data.data() + offset, binary.ptr.get(), binary.size );
+        offset += binary.size;
+        offsetData[i] = offset;
+    }
+}
+
+void Envelope::clear()
+{
+    getTypes().clear();
+    getOffsets().clear();
+    getData().clear();
+}
+
+size_t Envelope::getNumEvents() const
+{
+    return getOffsets().size();
+}
+
+bool Envelope::dispatch( const Handler& handler ) const
+{
+    const auto& types = getTypes();
+    const auto& offsets = getOffsets();
+    const auto& data = getData();
+    if( types.size() != 2 * offsets.size( ))
+        return false;
+
+    // validate first to not dispatch the front of a malformed envelope
+    uint64_t start = 0;
+    for( size_t i = 0; i < offsets.size(); ++i )
+    {
+        if( offsets[i] < start || offsets[i] > data.size( ))
+            return false;
+        start = offsets[i];
+    }
+
+    start = 0;
+    for( size_t i = 0; i < offsets.size(); ++i )
+    {
+        const servus::uint128_t type( types[ 2 * i ], types[ 2 * i + 1 ] );
+        handler( type, data.data() + start, offsets[i] - start );
+        start = offsets[i];
+    }
+    return true;
+}
+
+bool Envelope::dispatch(
+    const std::vector< servus::Serializable* >& receivers ) const
+{
+    bool success = true;
+    const bool wellFormed = dispatch(
+        [&]( const servus::uint128_t& type, const void* data, const size_t size )
+        {
+            for( auto* receiver : receivers )
+            {
+                if( receiver->getTypeIdentifier() == type &&
+                    !receiver->fromBinary( data, size ))
+                {
+                    success = false;
+                }
+            }
+        });
+    return wellFormed && success;
+}
+}
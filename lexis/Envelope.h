@@ -0,0 +1,81 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#pragma once
+
+#include <lexis/api.h>
+#include <lexis/detail/envelope.h> // base class
+
+#include <functional>
+#include <vector>
+
+namespace lexis
+{
+/**
+ * Several events packed into one message.
+ *
+ * A single interaction often changes several states at once, e.g. the
+ * render::Frame, render::ClipPlanes and render::MaterialLUT. Sending them in
+ * one Envelope pays the per-message overhead of the transport only once for
+ * all of them. The events are stored back to back in their binary
+ * representation and are dispatched in the order they were added, directly
+ * from the buffer of the envelope.
+ *
+ * Example:
+ * @code
+ * lexis::Envelope envelope;
+ * envelope.add({ &frame, &clipPlanes, &materialLUT });
+ * publisher.publish( envelope );
+ *
+ * // receiver, after the envelope was received
+ * envelope.dispatch({ &frame, &clipPlanes, &materialLUT });
+ * @endcode
+ */
+class Envelope : public detail::Envelope
+{
+public:
+    /** Called for each event with its type and binary representation. */
+    using Handler = std::function< void( const servus::uint128_t& type,
+                                         const void* data, size_t size ) >;
+
+    /** Append an event after the events already in the envelope. */
+    LEXIS_API void add( const servus::Serializable& event );
+
+    /**
+     * Append several events, growing the envelope buffers only once.
+     *
+     * @param events the events to append in order, must not be null
+     */
+    LEXIS_API void add( const std::vector< const servus::Serializable* >& events );
+
+    /** Remove all events from the envelope. */
+    LEXIS_API void clear();
+
+    /** @return the number of events in the envelope. */
+    LEXIS_API size_t getNumEvents() const;
+
+    /**
+     * Call the handler for each event in the envelope, in order.
+     *
+     * The data passed to the handler points into the envelope and is only
+     * valid during the call.
+     *
+     * @return false if the envelope is malformed, no event is dispatched then.
+     */
+    LEXIS_API bool dispatch( const Handler& handler ) const;
+
+    /**
+     * Deserialize each event into the receiver of the same type, in order.
+     *
+     * Events without receiver are skipped. The receivers emit their
+     * deserialized notification as if they had been received on their own.
+     *
+     * @param receivers the events to deserialize into, must not be null
+     * @return false if the envelope is malformed or an event could not be
+     *         deserialized.
+     */
+    LEXIS_API bool dispatch(
+        const std::vector< servus::Serializable* >& receivers ) const;
+};
+}
@@ -0,0 +1,140 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#pragma once
+
+#include <servus/serializable.h> // used inline
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace lexis
+{
+/**
+ * Pool of recycled events for receiving at high rates.
+ *
+ * Decoding into a new event for each message allocates the event and its
+ * storage every time. Events decoded by the pool are returned to it when
+ * released and are reused by later decodes, keeping their storage, so a
+ * steady stream of same-sized events does not allocate any memory once the
+ * pool is warm. Typical for render::ImageJPEG, render::Histogram or
+ * data::SelectedIDs handed from the receive thread to worker threads.
+ *
+ * The pool has to outlive all events acquired from it.
+ *
+ * Example:
+ * @code
+ * lexis::EventPool< lexis::render::ImageJPEG > pool;
+ * subscriber.subscribe( lexis::render::ImageJPEG::ZEROBUF_TYPE_IDENTIFIER(),
+ *     [&]( const void* data, const size_t size )
+ *     {
+ *         auto image = pool.decode( data, size );
+ *         if( image )
+ *             queue.push( std::move( image )); // returned to pool on release
+ *     });
+ * @endcode
+ */
+template< class T > class EventPool
+{
+public:
+    /** Returns released events to their pool. */
+    class Recycler
+    {
+    public:
+        explicit Recycler( EventPool* pool = nullptr ) : _pool( pool ) {}
+        void operator()( T* event ) const
+        {
+            if( _pool )
+                _pool->_release( event );
+            else
+                delete event;
+        }
+
+    private:
+        EventPool* _pool;
+    };
+
+    using Ptr = std::unique_ptr< T, Recycler >;
+
+    /**
+     * @param maxFree the maximum number of released events kept for reuse,
+     *                more are deleted on release.
+     */
+    explicit EventPool( const size_t maxFree = 16 )
+        : _maxFree( maxFree )
+    {
+        _free.reserve( maxFree );
+    }
+
+    ~EventPool()
+    {
+        for( T* event : _free )
+            delete event;
+    }
+
+    /**
+     * @return a recycled event with the content of its previous use, or a
+     *         new event if none is available. Thread safe.
+     */
+    Ptr acquire()
+    {
+        {
+            std::lock_guard< std::mutex > lock( _mutex );
+            if( !_free.empty( ))
+            {
+                T* event = _free.back();
+                _free.pop_back();
+                return Ptr( event, Recycler( this ));
+            }
+        }
+        return Ptr( new T, Recycler( this ));
+    }
+
+    /**
+     * Deserialize a received event into a recycled event. Thread safe.
+     *
+     * @return the decoded event, or an empty pointer if the data could not be
+     *         deserialized.
+     */
+    Ptr decode( const void* data, const size_t size )
+    {
+        Ptr event = acquire();
+        if( !static_cast< servus::Serializable& >( *event ).fromBinary( data,
+                                                                       size ))
+        {
+            return Ptr( nullptr, Recycler( this ));
+        }
+        return event;
+    }
+
+    /** @return the number of events available for reuse. Thread safe. */
+    size_t getNumFree() const
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        return _free.size();
+    }
+
+private:
+    EventPool( const EventPool& ) = delete;
+    EventPool& operator=( const EventPool& ) = delete;
+
+    const size_t _maxFree;
+    mutable std::mutex _mutex; // protects _free
+    std::vector< T* > _free; // reserved to _maxFree, never reallocated
+
+    void _release( T* event )
+    {
+        {
+            std::lock_guard< std::mutex > lock( _mutex );
+            if( _free.size() < _maxFree )
+            {
+                _free.push_back( event );
+                return;
+            }
+        }
+        delete event;
+    }
+};
+}
@@ -0,0 +1,237 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#include "base64.h"
+
+#include <algorithm>
+
+#if defined( __GNUC__ ) && ( defined( __x86_64__ ) || defined( __i386__ ))
+#  define LEXIS_BASE64_SSSE3
+#  include <tmmintrin.h>
+#endif
+
+namespace lexis
+{
+namespace
+{
+const char _encodeTable[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+const uint8_t _invalid = 0xff;
+
+struct DecodeTable
+{
+    DecodeTable()
+    {
+        std::fill( values, values + 256, _invalid );
+        for( uint8_t i = 0; i < 64; ++i )
+            values[ uint8_t( _encodeTable[ i ]) ] = i;
+    }
+    uint8_t values[ 256 ];
+};
+const DecodeTable _decodeTable;
+
+// Encodes size bytes to 4 * size / 3 characters, size must be a multiple of 3
+void _encodeScalar( const uint8_t* in, const size_t size, char* out )
+{
+    for( const uint8_t* end = in + size; in != end; in += 3, out += 4 )
+    {
+        const uint32_t word = ( uint32_t( in[0] ) << 16 ) |
+                              ( uint32_t( in[1] ) << 8 ) | in[2];
+        out[0] = _encodeTable[ ( word >> 18 ) & 0x3f ];
+        out[1] = _encodeTable[ ( word >> 12 ) & 0x3f ];
+        out[2] = _encodeTable[ ( word >> 6 ) & 0x3f ];
+        out[3] = _encodeTable[ word & 0x3f ];
+    }
+}
+
+// Decodes size characters to 3 * size / 4 bytes, size must be a multiple of 4
+bool _decodeScalar( const char* in, const size_t size, uint8_t* out )
+{
+    const uint8_t* table = _decodeTable.values;
+    for( const char* end = in + size; in != end; in += 4, out += 3 )
+    {
+        const uint8_t a = table[ uint8_t( in[0] )];
+        const uint8_t b = table[ uint8_t( in[1] )];
+        const uint8_t c = table[ uint8_t( in[2] )];
+        const uint8_t d = table[ uint8_t( in[3] )];
+        if(( a | b | c | d ) == _invalid )
+            return false;
+
+        const uint32_t word = ( uint32_t( a ) << 18 ) | ( uint32_t( b ) << 12 ) |
+                              ( uint32_t( c ) << 6 ) | d;
+        out[0] = uint8_t( word >> 16 );
+        out[1] = uint8_t( word >> 8 );
+        out[2] = uint8_t( word );
+    }
+    return true;
+}
+
+#ifdef LEXIS_BASE64_SSSE3
+// Vectorized codecs after W. Mula and D. Lemire, "Faster Base64 Encoding and
+// Decoding Using AVX2 Instructions", ACM TOW 2018, using the 128 bit variant.
+
+// Encodes 12 bytes to 16 characters per iteration, reading 16 bytes. Returns
+// the number of bytes consumed, which is a multiple of 12.
+__attribute__(( target( "ssse3" )))
+size_t _encodeSSSE3( const uint8_t* in, const size_t size, char* out )
+{
+    const __m128i shuffle = _mm_setr_epi8( 1, 0, 2, 1, 4, 3, 5, 4,
+                                           7, 6, 8, 7, 10, 9, 11, 10 );
+    const __m128i shift = _mm_setr_epi8( 'a' - 26, '0' - 52, '0' - 52,
+                                         '0' - 52, '0' - 52, '0' - 52,
+                                         '0' - 52, '0' - 52, '0' - 52,
+                                         '0' - 52, '0' - 52, '+' - 62,
+                                         '/' - 63, 'A', 0, 0 );
+    size_t done = 0;
+    for( ; done + 16 <= size; done += 12, out += 16 )
+    {
+        __m128i data = _mm_loadu_si128( (const __m128i*)( in + done ));
+        data = _mm_shuffle_epi8( data, shuffle );
+
+        // split each 3 byte group into four 6 bit indices, one per byte
+        const __m128i ac = _mm_mulhi_epu16(
+            _mm_and_si128( data, _mm_set1_epi32( 0x0fc0fc00 )),
+            _mm_set1_epi32( 0x04000040 ));
+        const __m128i bd = _mm_mullo_epi16(
+            _mm_and_si128( data, _mm_set1_epi32( 0x003f03f0 )),
+            _mm_set1_epi32( 0x01000010 ));
+        const __m128i indices = _mm_or_si128( ac, bd );
+
+        // map index ranges to the offset to their ASCII character
+        __m128i range = _mm_subs_epu8( indices, _mm_set1_epi8( 51 ));
+        const __m128i lower = _mm_cmpgt_epi8( _mm_set1_epi8( 26 ), indices );
+        range = _mm_or_si128( range,
+                              _mm_and_si128( lower, _mm_set1_epi8( 13 )));
+        const __m128i chars = _mm_add_epi8( indices,
+                                            _mm_shuffle_epi8( shift, range ));
+        _mm_storeu_si128( (__m128i*)out, chars );
+    }
+    return done;
+}
+
+// Decodes 16 characters to 12 bytes per iteration, writing 16 bytes. Returns
+// the number of characters consumed, which is a multiple of 16, or size + 1 on
+// invalid input.
+__attribute__(( target( "ssse3" )))
+size_t _decodeSSSE3( const char* in, const size_t size, uint8_t* out )
+{
+    const __m128i lutLo = _mm_setr_epi8( 0x15, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                         0x11, 0x11, 0x11, 0x11, 0x13, 0x1a,
+                                         0x1b, 0x1b, 0x1b, 0x1a );
+    const __m128i lutHi = _mm_setr_epi8( 0x10, 0x10, 0x01, 0x02, 0x04, 0x08,
+                                         0x04, 0x08, 0x10, 0x10, 0x10, 0x10,
+                                         0x10, 0x10, 0x10, 0x10 );
+    const __m128i lutRoll = _mm_setr_epi8( 0, 16, 19, 4, -65, -65, -71, -71,
+                                           0, 0, 0, 0, 0, 0, 0, 0 );
+    const __m128i pack = _mm_setr_epi8( 2, 1, 0, 6, 5, 4, 10, 9, 8,
+                                        14, 13, 12, -1, -1, -1, -1 );
+    const __m128i nibble = _mm_set1_epi8( 0x0f );
+
+    size_t done = 0;
+    for( ; done + 16 <= size; done += 16, out += 12 )
+    {
+        const __m128i data = _mm_loadu_si128( (const __m128i*)( in + done ));
+        const __m128i hiNibbles =
+            _mm_and_si128( _mm_srli_epi32( data, 4 ), nibble );
+        const __m128i loNibbles = _mm_and_si128( data, nibble );
+
+        const __m128i lo = _mm_shuffle_epi8( lutLo, loNibbles );
+        const __m128i hi = _mm_shuffle_epi8( lutHi, hiNibbles );
+        if( _mm_movemask_epi8( _mm_cmpgt_epi8( _mm_and_si128( lo, hi ),
+                                               _mm_setzero_si128( ))) != 0 )
+        {
+            return size + 1;
+        }
+
+        const __m128i isSlash = _mm_cmpeq_epi8( data, _mm_set1_epi8( '/' ));
+        const __m128i roll = _mm_shuffle_epi8( lutRoll,
+                                       _mm_add_epi8( isSlash, hiNibbles ));
+        const __m128i values = _mm_add_epi8( data, roll );
+
+        // merge four 6 bit values into three bytes
+        const __m128i pairs = _mm_maddubs_epi16( values,
+                                                 _mm_set1_epi32( 0x01400140 ));
+        const __m128i words = _mm_madd_epi16( pairs,
+                                              _mm_set1_epi32( 0x00011000 ));
+        _mm_storeu_si128( (__m128i*)out, _mm_shuffle_epi8( words, pack ));
+    }
+    return done;
+}
+
+const bool _hasSSSE3 = __builtin_cpu_supports( "ssse3" );
+#endif
+}
+
+std::string encodeBase64( const void* data, const size_t size )
+{
+    std::string encoded( ( size + 2 ) / 3 * 4, '=' );
+    if( size == 0 )
+        return encoded;
+
+    const uint8_t* in = static_cast< const uint8_t* >( data );
+    char* out = &encoded[0];
+    size_t done = 0;
+#ifdef LEXIS_BASE64_SSSE3
+    if( _hasSSSE3 )
+        done = _encodeSSSE3( in, size, out );
+#endif
+
+    const size_t tail = ( size - done ) % 3;
+    _encodeScalar( in + done, size - done - tail, out + done / 3 * 4 );
+
+    if( tail > 0 )
+    {
+        const uint8_t last[3] = { in[ size - tail ],
+                                  tail == 2 ? in[ size - 1 ] : uint8_t( 0 ),
+                                  0 };
+        char quad[4];
+        _encodeScalar( last, 3, quad );
+        std::copy( quad, quad + tail + 1, &encoded[ encoded.size() - 4 ] );
+    }
+    return encoded;
+}
+
+bool decodeBase64( const char* encoded, const size_t size,
+                   std::vector< uint8_t >& decoded )
+{
+    if( size % 4 != 0 )
+        return false;
+
+    size_t padding = 0;
+    if( size > 0 && encoded[ size - 1 ] == '=' )
+        padding = encoded[ size - 2 ] == '=' ? 2 : 1;
+
+    // reserve 4 extra bytes for the 16 byte stores of the vectorized decoder
+    decoded.resize( size / 4 * 3 + 4 );
+    uint8_t* out = decoded.data();
+
+    // the last quad may be padded, always decode it with the scalar code path
+    const size_t body = size > 0 ? size - 4 : 0;
+    size_t done = 0;
+#ifdef LEXIS_BASE64_SSSE3
+    if( _hasSSSE3 )
+    {
+        done = _decodeSSSE3( encoded, body, out );
+        if( done > body )
+            return false;
+    }
+#endif
+    if( !_decodeScalar( encoded + done, body - done, out + done / 4 * 3 ))
+        return false;
+
+    if( size > 0 )
+    {
+        char quad[4];
+        std::copy( encoded + body, encoded + size, quad );
+        std::fill( quad + 4 - padding, quad + 4, 'A' );
+        if( !_decodeScalar( quad, 4, out + body / 4 * 3 ))
+            return false;
+    }
+
+    decoded.resize( size / 4 * 3 - padding );
+    return true;
+}
+
+}
@@ -0,0 +1,46 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#pragma once
+
+#include <lexis/api.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace lexis
+{
+/**
+ * Encode binary data to base64, e.g. for the JSON representation of
+ * render::ImageJPEG, render::Histogram bins or data::SelectedIDs.
+ *
+ * Uses an SSSE3 code path when the CPU supports it and a table-driven scalar
+ * implementation otherwise. The output is padded with '=' and contains no line
+ * breaks.
+ *
+ * @param data the binary data to encode
+ * @param size the number of bytes to encode
+ * @return the base64 encoded string
+ */
+LEXIS_API std::string encodeBase64( const void* data, size_t size );
+
+/**
+ * Decode base64 encoded data.
+ *
+ * @param encoded the base64 string, padded with '=' and without line breaks
+ * @param size the number of characters in encoded
+ * @param decoded the decoded data, resized to the decoded size
+ * @return false if the input is not valid base64, true otherwise
+ */
+LEXIS_API bool decodeBase64( const char* encoded, size_t size,
+                             std::vector< uint8_t >& decoded );
+
+/** @overload */
+inline bool decodeBase64( const std::string& encoded,
+                          std::vector< uint8_t >& decoded )
+{
+    return decodeBase64( encoded.data(), encoded.size(), decoded );
+}
+}
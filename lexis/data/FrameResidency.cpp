@@ -0,0 +1,183 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#include "FrameResidency.h"
+
+#include <algorithm>
+
+namespace lexis
+{
+namespace data
+{
+namespace
+{
+typedef std::vector< uint32_t > Runs;
+
+// Runs are pairs of start and end, a malformed event with an odd number of
+// boundaries is treated as empty
+template< class V > bool _isValid( const V& runs )
+{
+    return runs.size() % 2 == 0;
+}
+
+template< class V > Runs _copy( const V& runs )
+{
+    if( !_isValid( runs ))
+        return Runs();
+    return Runs( runs.data(), runs.data() + runs.size( ));
+}
+
+template< class V > bool _contains( const V& runs, const uint32_t frame )
+{
+    if( !_isValid( runs ))
+        return false;
+
+    // frame is inside a run if the first boundary above it is an end
+    const uint32_t* begin = runs.data();
+    const uint32_t* end = begin + runs.size();
+    return ( std::upper_bound( begin, end, frame ) - begin ) % 2 == 1;
+}
+
+// Union of runs with [start, end), merging overlapping and adjacent runs
+Runs _insert( const Runs& runs, uint32_t start, uint32_t end )
+{
+    Runs result;
+    result.reserve( runs.size() + 2 );
+    size_t i = 0;
+    for( ; i < runs.size() && runs[ i + 1 ] < start; i += 2 )
+        result.insert( result.end(), { runs[i], runs[ i + 1 ] });
+    for( ; i < runs.size() && runs[i] <= end; i += 2 )
+    {
+        start = std::min( start, runs[i] );
+        end = std::max( end, runs[ i + 1 ] );
+    }
+    result.insert( result.end(), { start, end });
+    result.insert( result.end(), runs.begin() + i, runs.end( ));
+    return result;
+}
+
+// Difference of runs and [start, end)
+Runs _erase( const Runs& runs, const uint32_t start, const uint32_t end )
+{
+    Runs result;
+    result.reserve( runs.size() + 2 );
+    for( size_t i = 0; i < runs.size(); i += 2 )
+    {
+        const uint32_t runStart = runs[i];
+        const uint32_t runEnd = runs[ i + 1 ];
+        if( runEnd <= start || runStart >= end )
+        {
+            result.insert( result.end(), { runStart, runEnd });
+            continue;
+        }
+        if( runStart < start )
+            result.insert( result.end(), { runStart, start });
+        if( runEnd > end )
+            result.insert( result.end(), { end, runEnd });
+    }
+    return result;
+}
+}
+
+FrameResidency::State FrameResidency::getState( const uint32_t frame ) const
+{
+    if( _contains( getResident(), frame ))
+        return State::resident;
+    if( _contains( getLoading(), frame ))
+        return State::loading;
+    return State::absent;
+}
+
+void FrameResidency::setState( const uint32_t start, const uint32_t end,
+                               const State state )
+{
+    if( start >= end )
+        return;
+
+    Runs resident = _copy( getResident( ));
+    Runs loading = _copy( getLoading( ));
+    switch( state )
+    {
+    case State::absent:
+        resident = _erase( resident, start, end );
+        loading = _erase( loading, start, end );
+        break;
+    case State::loading:
+        resident = _erase( resident, start, end );
+        loading = _insert( loading, start, end );
+        break;
+    case State::resident:
+        resident = _insert( resident, start, end );
+        loading = _erase( loading, start, end );
+        break;
+    }
+    setResident( resident );
+    setLoading( loading );
+}
+
+size_t FrameResidency::getNumResident() const
+{
+    const auto& runs = getResident();
+    if( !_isValid( runs ))
+        return 0;
+
+    const uint32_t* data = runs.data();
+    size_t count = 0;
+    for( size_t i = 0; i < runs.size(); i += 2 )
+        count += data[ i + 1 ] - data[i];
+    return count;
+}
+
+bool FrameResidency::findNearestResident( const uint32_t frame,
+                                          uint32_t& nearest ) const
+{
+    const auto& runs = getResident();
+    if( runs.size() == 0 || !_isValid( runs ))
+        return false;
+
+    const uint32_t* begin = runs.data();
+    const uint32_t* end = begin + runs.size();
+    const size_t index = std::upper_bound( begin, end, frame ) - begin;
+    if( index % 2 == 1 )
+    {
+        nearest = frame;
+        return true;
+    }
+
+    // frame lies in the gap between the run ending at index - 1 and the run
+    // starting at index
+    if( index == 0 )
+        nearest = begin[0];
+    else if( index == runs.size( ))
+        nearest = begin[ index - 1 ] - 1;
+    else
+    {
+        const uint32_t before = begin[ index - 1 ] - 1;
+        const uint32_t after = begin[ index ];
+        nearest = frame - before < after - frame ? before : after;
+    }
+    return true;
+}
+
+FrameResidency& FrameResidency::operator|=( const FrameResidency& rhs )
+{
+    Runs resident = _copy( getResident( ));
+    Runs loading = _copy( getLoading( ));
+
+    const Runs rhsResident = _copy( rhs.getResident( ));
+    const Runs rhsLoading = _copy( rhs.getLoading( ));
+    for( size_t i = 0; i < rhsResident.size(); i += 2 )
+        resident = _insert( resident, rhsResident[i], rhsResident[ i + 1 ] );
+    for( size_t i = 0; i < rhsLoading.size(); i += 2 )
+        loading = _insert( loading, rhsLoading[i], rhsLoading[ i + 1 ] );
+    for( size_t i = 0; i < resident.size(); i += 2 )
+        loading = _erase( loading, resident[i], resident[ i + 1 ] );
+
+    setResident( resident );
+    setLoading( loading );
+    return *this;
+}
+
+}
+}
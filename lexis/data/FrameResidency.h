@@ -0,0 +1,69 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#ifndef LEXIS_DATA_FRAMERESIDENCY_H
+#define LEXIS_DATA_FRAMERESIDENCY_H
+
+#include <lexis/api.h>
+#include <lexis/data/detail/frameResidency.h> // base class
+
+namespace lexis
+{
+namespace data
+{
+/**
+ * Cache state of the data frames of a loader.
+ *
+ * Queries are logarithmic and updates linear in the number of runs, which is
+ * small for the typical contiguous cache contents. Run arrays of a malformed
+ * event with an odd number of boundaries are treated as empty.
+ */
+class FrameResidency : public detail::FrameResidency
+{
+public:
+    enum class State
+    {
+        absent,  //!< neither resident nor loading
+        loading, //!< being loaded
+        resident //!< decoded in memory
+    };
+
+    /** @return the cache state of the given frame. */
+    LEXIS_API State getState( uint32_t frame ) const;
+
+    /** @return true if the given frame is decoded in memory. */
+    bool isResident( uint32_t frame ) const
+        { return getState( frame ) == State::resident; }
+
+    /** Set the cache state of the frames in [start, end). */
+    LEXIS_API void setState( uint32_t start, uint32_t end, State state );
+
+    /** Set the cache state of a single frame. */
+    void setState( uint32_t frame, State state )
+        { setState( frame, frame + 1, state ); }
+
+    /** @return the number of resident frames. */
+    LEXIS_API size_t getNumResident() const;
+
+    /**
+     * Find the resident frame closest to the given frame, preferring later
+     * frames on ties.
+     *
+     * @param frame the requested frame
+     * @param nearest set to the closest resident frame if one exists
+     * @return false if no frame is resident.
+     */
+    LEXIS_API bool findNearestResident( uint32_t frame,
+                                        uint32_t& nearest ) const;
+
+    /**
+     * Merge the state of another loader. Frames resident in either are
+     * resident, other frames loading in either are loading.
+     */
+    LEXIS_API FrameResidency& operator|=( const FrameResidency& rhs );
+};
+}
+}
+
+#endif
@@ -0,0 +1,45 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#include "PeriodicThread.h"
+
+namespace lexis
+{
+namespace detail
+{
+PeriodicThread::PeriodicThread( const std::function< void() >& func,
+                                const std::chrono::milliseconds interval )
+    : _func( func )
+    , _interval( interval )
+    , _thread( [this] { _run(); } )
+{
+}
+
+PeriodicThread::~PeriodicThread()
+{
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        _running = false;
+    }
+    _condition.notify_all();
+    _thread.join();
+}
+
+void PeriodicThread::_run()
+{
+    std::unique_lock< std::mutex > lock( _mutex );
+    while( _running )
+    {
+        _condition.wait_for( lock, _interval, [this] { return !_running; });
+        if( !_running )
+            return;
+
+        lock.unlock();
+        _func();
+        lock.lock();
+    }
+}
+
+}
+}
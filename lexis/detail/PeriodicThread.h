@@ -0,0 +1,46 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace lexis
+{
+namespace detail
+{
+/**
+ * Calls a function periodically from a thread, e.g. to publish the state
+ * accumulated by CoalescingPublisher or render::TelemetryCollector.
+ */
+class PeriodicThread
+{
+public:
+    /** Start the thread, the first call is after one interval. */
+    PeriodicThread( const std::function< void() >& func,
+                    std::chrono::milliseconds interval );
+
+    /** Stop the thread after a running call, without a final call. */
+    ~PeriodicThread();
+
+private:
+    PeriodicThread( const PeriodicThread& ) = delete;
+    PeriodicThread& operator=( const PeriodicThread& ) = delete;
+
+    const std::function< void() > _func;
+    const std::chrono::milliseconds _interval;
+
+    std::mutex _mutex; // protects _running
+    bool _running = true;
+    std::condition_variable _condition;
+    std::thread _thread;
+
+    void _run();
+};
+}
+}
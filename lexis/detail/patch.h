@@ -0,0 +1,63 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// Diff and patch of the array fields of versioned events, e.g. the planes of
+// render::ClipPlanes or the channels of render::MaterialLUT
+namespace lexis
+{
+namespace detail
+{
+/**
+ * @param base the array known to the receiver
+ * @param values the current array
+ * @param start set to the index of the first returned entry
+ * @return the entries of values from the first to the last one differing from
+ *         base, or to the end if the sizes differ.
+ */
+template< class T >
+std::vector< T > diffRange( const std::vector< T >& base,
+                            const std::vector< T >& values, uint32_t& start )
+{
+    const size_t common = std::min( base.size(), values.size( ));
+    size_t first = 0;
+    while( first < common && base[ first ] == values[ first ] )
+        ++first;
+    size_t end = values.size();
+    if( base.size() == values.size( ))
+    {
+        while( end > first && base[ end - 1 ] == values[ end - 1 ] )
+            --end;
+    }
+    start = uint32_t( first );
+    return std::vector< T >( values.begin() + first, values.begin() + end );
+}
+
+/**
+ * Resize values to size entries and replace the entries from start on.
+ *
+ * @return false if the replacement does not fit into size entries or does not
+ *         cover all added entries, values are left unchanged then.
+ */
+template< class T >
+bool patchRange( std::vector< T >& values, const size_t size,
+                 const size_t start, const std::vector< T >& replacement )
+{
+    if( start > size || replacement.size() > size - start ||
+        ( size > values.size() && start + replacement.size() < size ))
+    {
+        return false;
+    }
+
+    values.resize( size );
+    std::copy( replacement.begin(), replacement.end(), values.begin() + start );
+    return true;
+}
+}
+}
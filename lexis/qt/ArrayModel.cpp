@@ -0,0 +1,110 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#include "ArrayModel.h"
+
+#include <cstring>
+
+namespace lexisqt
+{
+ArrayModel::ArrayModel( QObject* parentObject )
+    : QAbstractListModel( parentObject )
+{
+}
+
+void ArrayModel::setValues( const uint32_t* values, const size_t count )
+{
+    _setValues( values, count, Type::uint32 );
+}
+
+void ArrayModel::setValues( const uint64_t* values, const size_t count )
+{
+    _setValues( values, count, Type::uint64 );
+}
+
+void ArrayModel::setValues( const float* values, const size_t count )
+{
+    _setValues( values, count, Type::float32 );
+}
+
+void ArrayModel::setValues( const double* values, const size_t count )
+{
+    _setValues( values, count, Type::float64 );
+}
+
+QVariant ArrayModel::get( const int index ) const
+{
+    if( index < 0 || size_t( index ) >= _count )
+        return QVariant( 0 );
+
+    const uint8_t* value = _values.data();
+    switch( _type )
+    {
+    case Type::uint32:
+        return QVariant( reinterpret_cast< const uint32_t* >( value )[index] );
+    case Type::uint64:
+        return QVariant( qulonglong(
+            reinterpret_cast< const uint64_t* >( value )[index] ));
+    case Type::float32:
+        return QVariant( reinterpret_cast< const float* >( value )[index] );
+    case Type::float64:
+        return QVariant( reinterpret_cast< const double* >( value )[index] );
+    }
+    return QVariant( 0 );
+}
+
+int ArrayModel::rowCount( const QModelIndex& parentIndex ) const
+{
+    return parentIndex.isValid() ? 0 : int( _count );
+}
+
+QVariant ArrayModel::data( const QModelIndex& index, const int role ) const
+{
+    if( role != ValueRole && role != Qt::DisplayRole )
+        return QVariant();
+    return get( index.row( ));
+}
+
+QHash< int, QByteArray > ArrayModel::roleNames() const
+{
+    return {{ ValueRole, "value" }};
+}
+
+template< class T >
+void ArrayModel::_setValues( const T* values, const size_t count,
+                             const Type type )
+{
+    const size_t size = count * sizeof( T );
+    if( type != _type || count != _count )
+    {
+        const bool countChange = count != _count;
+        beginResetModel();
+        _values.resize( size );
+        if( size > 0 )
+            ::memcpy( _values.data(), values, size );
+        _type = type;
+        _count = count;
+        endResetModel();
+        if( countChange )
+            emit countChanged();
+        return;
+    }
+
+    // notify about the range of changed values only
+    const T* current = reinterpret_cast< const T* >( _values.data( ));
+    size_t first = 0;
+    while( first < count && current[ first ] == values[ first ] )
+        ++first;
+    if( first == count )
+        return;
+    size_t last = count - 1;
+    while( last > first && current[ last ] == values[ last ] )
+        --last;
+
+    ::memcpy( _values.data() + first * sizeof( T ), values + first,
+              ( last - first + 1 ) * sizeof( T ));
+    emit dataChanged( index( int( first )), index( int( last )),
+                      { ValueRole, Qt::DisplayRole });
+}
+}
@@ -0,0 +1,74 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#pragma once
+
+#include <lexisqt/api.h>
+
+#include <QAbstractListModel>
+
+#include <cstdint>
+#include <vector>
+
+namespace lexisqt
+{
+/**
+ * List model exposing a large numeric array, e.g. histogram bins or IDs, to
+ * QML without converting it to a QVariantList on each update.
+ *
+ * The values are stored in their native type in a buffer reused between
+ * updates and converted to a QVariant only when a view reads an element. An
+ * update of the same size only notifies about the range of changed values.
+ */
+class LEXISQT_API ArrayModel : public QAbstractListModel
+{
+    Q_OBJECT
+    Q_PROPERTY( int count READ getCount NOTIFY countChanged )
+
+public:
+    enum Roles
+    {
+        ValueRole = Qt::UserRole + 1 //!< the value, named "value" in QML
+    };
+
+    explicit ArrayModel( QObject* parent = nullptr );
+
+    /** Replace the values of the model. @{ */
+    void setValues( const uint32_t* values, size_t count );
+    void setValues( const uint64_t* values, size_t count );
+    void setValues( const float* values, size_t count );
+    void setValues( const double* values, size_t count );
+    /** @} */
+
+    /** @return the number of values. */
+    int getCount() const { return int( _count ); }
+
+    /** @return the value at the index, 0 if out of range. */
+    Q_INVOKABLE QVariant get( int index ) const;
+
+    int rowCount( const QModelIndex& parent = QModelIndex( )) const override;
+    QVariant data( const QModelIndex& index,
+                   int role = ValueRole ) const override;
+    QHash< int, QByteArray > roleNames() const override;
+
+signals:
+    void countChanged();
+
+private:
+    enum class Type
+    {
+        uint32,
+        uint64,
+        float32,
+        float64
+    };
+
+    std::vector< uint8_t > _values;
+    Type _type = Type::float64;
+    size_t _count = 0;
+
+    template< class T >
+    void _setValues( const T* values, size_t count, Type type );
+};
+}
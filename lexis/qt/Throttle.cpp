@@ -0,0 +1,87 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#include "Throttle.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace lexisqt
+{
+Throttle::Throttle( servus::Serializable& target, const int interval,
+                    QObject* parentObject )
+    : QObject( parentObject )
+    , _target( target )
+    , _interval( interval )
+{
+    _timer.setSingleShot( true );
+    connect( &_timer, &QTimer::timeout, this, &Throttle::flush );
+}
+
+void Throttle::update( const void* data, const size_t size )
+{
+    bool schedule = false;
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        _pending.resize( size );
+        if( size > 0 )
+            ::memcpy( _pending.data(), data, size );
+        schedule = !_dirty;
+        _dirty = true;
+    }
+
+    // the timer is only to be started from the thread of this object
+    if( schedule )
+        QMetaObject::invokeMethod( this, "_schedule", Qt::QueuedConnection );
+}
+
+void Throttle::update( const servus::Serializable& event )
+{
+    const auto binary = event.toBinary();
+    update( binary.ptr.get(), binary.size );
+}
+
+void Throttle::setInterval( const int interval )
+{
+    if( interval == _interval )
+        return;
+
+    _interval = interval;
+    _timer.stop();
+    _schedule();
+    emit intervalChanged();
+}
+
+void Throttle::flush()
+{
+    _timer.stop();
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        if( !_dirty )
+            return;
+        _pending.swap( _applying );
+        _dirty = false;
+    }
+
+    // deserialize without the lock, the target emits its signals
+    if( !_target.fromBinary( _applying.data(), _applying.size( )))
+        return;
+    _lastUpdate.start();
+    emit updated();
+}
+
+void Throttle::_schedule()
+{
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        if( !_dirty || _interval <= 0 || _timer.isActive( ))
+            return;
+    }
+
+    // the first update after a quiet period is applied right away
+    const qint64 elapsed = _lastUpdate.isValid() ? _lastUpdate.elapsed()
+                                                 : _interval;
+    _timer.start( int( std::max( qint64( 0 ), _interval - elapsed )));
+}
+}
@@ -0,0 +1,95 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#pragma once
+
+#include <lexisqt/api.h>
+#include <servus/serializable.h> // member
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QTimer>
+
+#include <mutex>
+#include <vector>
+
+namespace lexisqt
+{
+/**
+ * Rate-limited updates of a LexisQt object from a high-rate event stream.
+ *
+ * Received events are stored as the latest pending binary update, replacing
+ * any update not yet applied. The pending update is deserialized into the
+ * target, which then emits its change signals, at most once per interval, or
+ * only on flush() with an interval of 0, e.g. once per frame by connecting
+ * flush() to QQuickWindow::beforeSynchronizing().
+ *
+ * Example:
+ * @code
+ * lexisqt::render::LookOut lookOut;
+ * lexisqt::Throttle throttle( lookOut, 40 );
+ * subscriber.subscribe( lexis::render::LookOut::ZEROBUF_TYPE_IDENTIFIER(),
+ *     [&]( const void* data, const size_t size )
+ *         { throttle.update( data, size ); });
+ * @endcode
+ */
+class LEXISQT_API Throttle : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY( int interval READ getInterval WRITE setInterval
+                NOTIFY intervalChanged )
+
+public:
+    /**
+     * @param target the object to update, must outlive the throttle
+     * @param interval the minimum time between two updates of the target in
+     *                 milliseconds, 0 to only update on flush()
+     * @param parent the parent object
+     */
+    Throttle( servus::Serializable& target, int interval = 16,
+              QObject* parent = nullptr );
+
+    /**
+     * Schedule the binary representation of a received event for the target.
+     * Thread safe.
+     */
+    void update( const void* data, size_t size );
+
+    /** Schedule an event for the target. Thread safe. */
+    void update( const servus::Serializable& event );
+
+    /** @return the minimum time between two updates in milliseconds. */
+    int getInterval() const { return _interval; }
+
+    /** Set the minimum time between two updates in milliseconds. */
+    void setInterval( int interval );
+
+public slots:
+    /**
+     * Apply the pending update, if any, to the target now. An update rejected
+     * by the target is dropped.
+     */
+    void flush();
+
+signals:
+    /** Emitted after the target was updated successfully. */
+    void updated();
+
+    void intervalChanged();
+
+private slots:
+    void _schedule();
+
+private:
+    servus::Serializable& _target;
+    int _interval;
+    QTimer _timer;
+    QElapsedTimer _lastUpdate;
+
+    std::mutex _mutex; // protects _pending and _dirty
+    std::vector< uint8_t > _pending;
+    bool _dirty = false;
+    std::vector< uint8_t > _applying; // keeps its capacity between updates
+};
+}
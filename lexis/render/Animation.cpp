@@ -0,0 +1,100 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#include "Animation.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace lexis
+{
+namespace render
+{
+
+Animation::Animation( const double fps )
+    : _fps( fps )
+{
+}
+
+void Animation::setFrame( const Frame& frame )
+{
+    _frame = frame;
+    _frame.setCurrent( _advance( 0 ));
+}
+
+bool Animation::setFrameRange( const data::FrameRange& range )
+{
+    const Frame old = _frame;
+    _frame.setStart( std::min( std::max( _frame.getStart(), range.getStart( )),
+                               range.getEnd( )));
+    _frame.setEnd( std::max( std::min( _frame.getEnd(), range.getEnd( )),
+                             _frame.getStart( )));
+    _frame.setCurrent( _advance( 0 ));
+    return _frame != old;
+}
+
+void Animation::setFPS( const double fps )
+{
+    _fps = fps;
+}
+
+bool Animation::update( const Clock::time_point now )
+{
+    if( !_running || _frame.getDelta() == 0 || _fps <= 0.0 )
+    {
+        _running = true;
+        _last = now;
+        return false;
+    }
+
+    const std::chrono::duration< double > elapsed = now - _last;
+    const int64_t steps = int64_t( std::floor( elapsed.count() * _fps ));
+    if( steps <= 0 )
+        return false;
+
+    // keep the fraction of the next step for smooth playback at any fps
+    _last += std::chrono::duration_cast< Clock::duration >(
+                 std::chrono::duration< double >( double( steps ) / _fps ));
+
+    const uint32_t current = _advance( steps );
+    if( current == _frame.getCurrent( ))
+        return false;
+    _frame.setCurrent( current );
+    return true;
+}
+
+data::FramePrefetch Animation::getPrefetch( const size_t count ) const
+{
+    data::FramePrefetch prefetch;
+    if( _frame.getDelta() == 0 )
+        return prefetch;
+
+    std::vector< uint32_t > frames;
+    for( int64_t i = 1; frames.size() < count; ++i )
+    {
+        const uint32_t frame = _advance( i );
+        if( frame == _frame.getCurrent( ))
+            break; // looped over all frames
+        frames.push_back( frame );
+    }
+    prefetch.setFrames( frames );
+    return prefetch;
+}
+
+uint32_t Animation::_advance( const int64_t steps ) const
+{
+    const int64_t start = _frame.getStart();
+    const int64_t size = int64_t( _frame.getEnd( )) - start;
+    if( size <= 0 )
+        return _frame.getStart();
+
+    int64_t offset = ( int64_t( _frame.getCurrent( )) - start +
+                       steps * _frame.getDelta( )) % size;
+    if( offset < 0 )
+        offset += size;
+    return uint32_t( start + offset );
+}
+
+}
+}
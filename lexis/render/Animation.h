@@ -0,0 +1,84 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#pragma once
+
+#include <lexis/api.h>
+#include <lexis/data/frameRange.h>
+#include <lexis/data/framePrefetch.h>
+#include <lexis/render/frame.h>
+
+#include <chrono>
+
+namespace lexis
+{
+namespace render
+{
+
+/**
+ * Animation playback of a Frame event on a steady clock.
+ *
+ * The current frame advances by Frame::delta every 1/fps seconds and wraps
+ * within [start, end) of the frame. A delta of 0 pauses the playback. Besides
+ * the Frame event to publish after each update, the animation provides the
+ * FramePrefetch event announcing the frames played next to the data loaders.
+ */
+class Animation
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /** @param fps the number of animation steps per second */
+    LEXIS_API explicit Animation( double fps = 25.0 );
+
+    /** @return the animated frame, to be published after an update. */
+    const Frame& getFrame() const { return _frame; }
+
+    /**
+     * Set the animation loop and step. The current frame is wrapped into the
+     * new [start, end) range.
+     */
+    LEXIS_API void setFrame( const Frame& frame );
+
+    /**
+     * Restrict the animation loop to the available data frames.
+     *
+     * @param range the [start, end) frames available from the data source
+     * @return true if the animated frame has changed.
+     */
+    LEXIS_API bool setFrameRange( const data::FrameRange& range );
+
+    /** Set the number of animation steps per second. */
+    LEXIS_API void setFPS( double fps );
+
+    /** @return the number of animation steps per second. */
+    double getFPS() const { return _fps; }
+
+    /**
+     * Advance the current frame by the number of steps elapsed since the last
+     * update. The first update only starts the clock.
+     *
+     * @param now the current time
+     * @return true if the current frame has changed.
+     */
+    LEXIS_API bool update( Clock::time_point now = Clock::now( ));
+
+    /**
+     * @param count the maximum number of frames to announce
+     * @return the next frames to be played after the current one, without
+     *         duplicates and empty if the animation is paused.
+     */
+    LEXIS_API data::FramePrefetch getPrefetch( size_t count ) const;
+
+private:
+    Frame _frame;
+    double _fps;
+    Clock::time_point _last;
+    bool _running = false;
+
+    uint32_t _advance( int64_t steps ) const;
+};
+
+}
+}
@@ -4,12 +4,203 @@
 
 #include "ClipPlanes.h"
 
+#include <lexis/detail/patch.h>
 #include <vmmlib/aabb.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#ifdef __SSE__
+#  include <xmmintrin.h>
+#endif
+
 namespace lexis
 {
 namespace render
 {
+namespace
+{
+typedef std::vector< detail::Plane > Planes;
+
+template< class V > Planes _copy( const V& planes )
+{
+    return Planes( planes.begin(), planes.end( ));
+}
+
+// Planes are processed in blocks of four as nx[4], ny[4], nz[4], d[4]
+const size_t _blockSize = 16;
+
+size_t _getNumBlocks( const size_t nPlanes )
+{
+    return ( nPlanes + 3 ) / 4;
+}
+
+// Pad the lanes after nPlanes with planes which never clip
+void _pad( float* blocks, const size_t nPlanes )
+{
+    const size_t nLanes = _getNumBlocks( nPlanes ) * 4;
+    for( size_t lane = nPlanes; lane < nLanes; ++lane )
+    {
+        float* block = blocks + lane / 4 * _blockSize;
+        for( size_t i = 0; i < 3; ++i )
+            block[ i * 4 + lane % 4 ] = 0.0f;
+        block[ 12 + lane % 4 ] = 1.0f;
+    }
+}
+
+// Invert a column-major matrix using Gauss-Jordan elimination with partial
+// pivoting, the result is column-major as well
+bool _invert( const double* matrix, double* inverse )
+{
+    double a[4][8];
+    for( size_t row = 0; row < 4; ++row )
+    {
+        for( size_t col = 0; col < 4; ++col )
+        {
+            a[row][col] = matrix[ col * 4 + row ];
+            a[row][ col + 4 ] = row == col ? 1.0 : 0.0;
+        }
+    }
+
+    for( size_t col = 0; col < 4; ++col )
+    {
+        size_t pivot = col;
+        for( size_t row = col + 1; row < 4; ++row )
+            if( std::abs( a[row][col] ) > std::abs( a[pivot][col] ))
+                pivot = row;
+        if( std::abs( a[pivot][col] ) < 1e-12 )
+            return false;
+        std::swap( a[pivot], a[col] );
+
+        const double scale = 1.0 / a[col][col];
+        for( size_t i = 0; i < 8; ++i )
+            a[col][i] *= scale;
+        for( size_t row = 0; row < 4; ++row )
+        {
+            if( row == col )
+                continue;
+            const double factor = a[row][col];
+            for( size_t i = 0; i < 8; ++i )
+                a[row][i] -= factor * a[col][i];
+        }
+    }
+
+    for( size_t row = 0; row < 4; ++row )
+        for( size_t col = 0; col < 4; ++col )
+            inverse[ col * 4 + row ] = a[row][ col + 4 ];
+    return true;
+}
+
+// A plane transforms with the inverse of the point transformation as row
+// vector: out_j = nx * inv(0,j) + ny * inv(1,j) + nz * inv(2,j) + d * inv(3,j)
+void _transform( const float* in, const float* inverse, const size_t nBlocks,
+                 float* out )
+{
+#ifdef __SSE__
+    __m128 m[16];
+    for( size_t i = 0; i < 16; ++i )
+        m[i] = _mm_set1_ps( inverse[i] );
+
+    for( size_t block = 0; block < nBlocks; ++block )
+    {
+        const float* src = in + block * _blockSize;
+        float* dst = out + block * _blockSize;
+        const __m128 x = _mm_loadu_ps( src );
+        const __m128 y = _mm_loadu_ps( src + 4 );
+        const __m128 z = _mm_loadu_ps( src + 8 );
+        const __m128 d = _mm_loadu_ps( src + 12 );
+        for( size_t j = 0; j < 4; ++j )
+        {
+            const __m128* column = m + j * 4;
+            const __m128 result =
+                _mm_add_ps( _mm_add_ps( _mm_mul_ps( x, column[0] ),
+                                        _mm_mul_ps( y, column[1] )),
+                            _mm_add_ps( _mm_mul_ps( z, column[2] ),
+                                        _mm_mul_ps( d, column[3] )));
+            _mm_storeu_ps( dst + j * 4, result );
+        }
+    }
+#else
+    for( size_t block = 0; block < nBlocks; ++block )
+    {
+        const float* src = in + block * _blockSize;
+        float* dst = out + block * _blockSize;
+        for( size_t j = 0; j < 4; ++j )
+        {
+            const float* column = inverse + j * 4;
+            for( size_t lane = 0; lane < 4; ++lane )
+                dst[ j * 4 + lane ] = src[lane] * column[0] +
+                                      src[ 4 + lane ] * column[1] +
+                                      src[ 8 + lane ] * column[2] +
+                                      src[ 12 + lane ] * column[3];
+        }
+    }
+#endif
+}
+}
+
+bool ViewClipPlanes::isOutside( const vmml::AABBf& box ) const
+{
+    // the box is outside if its corner furthest along the normal of any plane
+    // is behind it: n.center + d + |n|.extent < 0
+    const vmml::Vector3f& min = box.getMin();
+    const vmml::Vector3f& max = box.getMax();
+    float center[3];
+    float extent[3];
+    for( size_t i = 0; i < 3; ++i )
+    {
+        center[i] = 0.5f * ( min[i] + max[i] );
+        extent[i] = 0.5f * ( max[i] - min[i] );
+    }
+
+    const float* data = blocks.data();
+    const size_t nBlocks = getNumBlocks();
+#ifdef __SSE__
+    const __m128 signMask = _mm_set1_ps( -0.0f );
+    const __m128 zero = _mm_setzero_ps();
+    __m128 c[3];
+    __m128 e[3];
+    for( size_t i = 0; i < 3; ++i )
+    {
+        c[i] = _mm_set1_ps( center[i] );
+        e[i] = _mm_set1_ps( extent[i] );
+    }
+
+    for( size_t block = 0; block < nBlocks; ++block )
+    {
+        const float* planes = data + block * _blockSize;
+        __m128 distance = _mm_loadu_ps( planes + 12 );
+        for( size_t i = 0; i < 3; ++i )
+        {
+            const __m128 normal = _mm_loadu_ps( planes + i * 4 );
+            distance = _mm_add_ps( distance, _mm_mul_ps( normal, c[i] ));
+            distance = _mm_add_ps( distance,
+                                   _mm_mul_ps( _mm_andnot_ps( signMask, normal ),
+                                               e[i] ));
+        }
+        if( _mm_movemask_ps( _mm_cmplt_ps( distance, zero )) != 0 )
+            return true;
+    }
+#else
+    for( size_t block = 0; block < nBlocks; ++block )
+    {
+        const float* planes = data + block * _blockSize;
+        for( size_t lane = 0; lane < 4; ++lane )
+        {
+            float distance = planes[ 12 + lane ];
+            for( size_t i = 0; i < 3; ++i )
+            {
+                const float normal = planes[ i * 4 + lane ];
+                distance += normal * center[i] + std::abs( normal ) * extent[i];
+            }
+            if( distance < 0.0f )
+                return true;
+        }
+    }
+#endif
+    return false;
+}
 
 ClipPlanes::ClipPlanes()
 {
@@ -50,5 +241,85 @@ bool ClipPlanes::isOutside( const vmml::AABBf& worldBox ) const
     return false;
 }
 
+ClipPlanesPatch ClipPlanes::diff( const ClipPlanes& base ) const
+{
+    const Planes basePlanes = _copy( base.getPlanes( ));
+    const Planes planes = _copy( getPlanes( ));
+
+    uint32_t start = 0;
+    ClipPlanesPatch patch;
+    patch.setBaseVersion( base.getVersion( ));
+    patch.setVersion( getVersion( ));
+    patch.setSize( uint32_t( planes.size( )));
+    patch.setPlanes( lexis::detail::diffRange( basePlanes, planes, start ));
+    patch.setStart( start );
+    return patch;
+}
+
+bool ClipPlanes::apply( const ClipPlanesPatch& patch )
+{
+    Planes planes = _copy( getPlanes( ));
+    if( patch.getBaseVersion() != getVersion() ||
+        !lexis::detail::patchRange( planes, patch.getSize(), patch.getStart(),
+                                    _copy( patch.getPlanes( ))))
+    {
+        return false;
+    }
+
+    setPlanes( planes );
+    setVersion( patch.getVersion( ));
+    return true;
+}
+
+const ViewClipPlanes& ClipPlanes::transform( const double* matrix ) const
+{
+    return transform( matrix, 1 ).front();
+}
+
+const std::vector< ViewClipPlanes >&
+ClipPlanes::transform( const double* matrices, const size_t nViews ) const
+{
+    // gather the world space planes once for all views
+    const auto& planes = getPlanes();
+    const size_t nPlanes = planes.size();
+    const size_t nBlocks = _getNumBlocks( nPlanes );
+    _worldBlocks.resize( nBlocks * _blockSize );
+    size_t lane = 0;
+    for( const auto& plane : planes )
+    {
+        float* block = _worldBlocks.data() + lane / 4 * _blockSize;
+        const float* normal = plane.getNormal();
+        for( size_t i = 0; i < 3; ++i )
+            block[ i * 4 + lane % 4 ] = normal[i];
+        block[ 12 + lane % 4 ] = plane.getD();
+        ++lane;
+    }
+    _pad( _worldBlocks.data(), nPlanes );
+
+    _views.resize( nViews );
+    for( size_t view = 0; view < nViews; ++view )
+    {
+        std::vector< float >& blocks = _views[ view ].blocks;
+        blocks.resize( nBlocks * _blockSize );
+
+        double inverse[16];
+        if( !_invert( matrices + view * 16, inverse ))
+        {
+            std::fill( blocks.begin(), blocks.end(), 0.0f );
+            for( size_t block = 0; block < nBlocks; ++block )
+                std::fill_n( blocks.begin() + block * _blockSize + 12, 4, 1.0f );
+            continue;
+        }
+
+        float inverseF[16];
+        std::copy( inverse, inverse + 16, inverseF );
+        _transform( _worldBlocks.data(), inverseF, nBlocks, blocks.data( ));
+
+        // keep the padding lanes neutral for projective matrices
+        _pad( blocks.data(), nPlanes );
+    }
+    return _views;
+}
+
 }
 }
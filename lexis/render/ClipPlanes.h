@@ -8,11 +8,34 @@
 #include <lexis/render/detail/clipPlanes.h>
 #include <vmmlib/types.hpp>
 
+#include <vector>
+
 namespace lexis
 {
 namespace render
 {
 
+using ClipPlanesPatch = detail::ClipPlanesPatch;
+
+/**
+ * Clip planes transformed into the space of a view, laid out for culling.
+ *
+ * The planes are stored in blocks of four, each block holding the x, y and z
+ * normal components and the d values of its four planes. The last block is
+ * padded with planes which never clip. The normals are not normalized.
+ */
+struct ViewClipPlanes
+{
+    /** 16 floats per block: nx[4], ny[4], nz[4], d[4]. */
+    std::vector< float > blocks;
+
+    /** @return the number of blocks of four planes. */
+    size_t getNumBlocks() const { return blocks.size() / 16; }
+
+    /** @return true if the box in view space is outside the clip planes. */
+    LEXIS_API bool isOutside( const vmml::AABBf& box ) const;
+};
+
 class ClipPlanes : public detail::ClipPlanes
 {
 public:
@@ -33,6 +56,47 @@ public:
 
     /** @return true if the box is outside the clip planes, aka shall be clipped.*/
     LEXIS_API bool isOutside( const vmml::AABBf& box ) const;
+
+    /**
+     * @param base the clip planes known to the receiver
+     * @return the patch replacing the planes which differ from base.
+     */
+    LEXIS_API ClipPlanesPatch diff( const ClipPlanes& base ) const;
+
+    /**
+     * Apply a patch in place.
+     *
+     * @return false if the patch does not apply to the version of these clip
+     *         planes, they are left unchanged then.
+     */
+    LEXIS_API bool apply( const ClipPlanesPatch& patch );
+
+    /**
+     * Transform the planes into the space of a view.
+     *
+     * @param matrix the column-major 4x4 matrix from world to view space, as in
+     *               LookOut::getMatrix()
+     * @return the planes in view space, valid until the next transform. A
+     *         singular matrix results in planes which never clip.
+     */
+    LEXIS_API const ViewClipPlanes& transform( const double* matrix ) const;
+
+    /**
+     * Transform the planes into the spaces of several views at once, e.g. the
+     * tiles of a display wall or the eyes of a stereo setup.
+     *
+     * @param matrices nViews consecutive column-major 4x4 matrices from world
+     *                 to view space
+     * @param nViews the number of views
+     * @return the planes of each view, valid until the next transform. The
+     *         storage is reused between calls, which are not thread safe.
+     */
+    LEXIS_API const std::vector< ViewClipPlanes >&
+    transform( const double* matrices, size_t nViews ) const;
+
+private:
+    mutable std::vector< float > _worldBlocks;
+    mutable std::vector< ViewClipPlanes > _views;
 };
 
 }
@@ -0,0 +1,259 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#include "LookOutPredictor.h"
+
+#include <vmmlib/vector.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace lexis
+{
+namespace render
+{
+namespace
+{
+// OpenGL matrices are column-major
+double _get( const double* matrix, const size_t row, const size_t col )
+{
+    return matrix[ col * 4 + row ];
+}
+
+void _normalize( double* quaternion )
+{
+    const double length = std::sqrt( quaternion[0] * quaternion[0] +
+                                     quaternion[1] * quaternion[1] +
+                                     quaternion[2] * quaternion[2] +
+                                     quaternion[3] * quaternion[3] );
+    for( size_t i = 0; i < 4; ++i )
+        quaternion[i] /= length;
+}
+
+double _dot( const double* a, const double* b )
+{
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+}
+
+// Rotation matrix to quaternion, after K. Shoemake, "Animating rotation with
+// quaternion curves", SIGGRAPH 1985
+void _toQuaternion( const double r[3][3], double* q )
+{
+    const double trace = r[0][0] + r[1][1] + r[2][2];
+    if( trace > 0.0 )
+    {
+        const double s = 0.5 / std::sqrt( trace + 1.0 );
+        q[0] = 0.25 / s;
+        q[1] = ( r[2][1] - r[1][2] ) * s;
+        q[2] = ( r[0][2] - r[2][0] ) * s;
+        q[3] = ( r[1][0] - r[0][1] ) * s;
+    }
+    else if( r[0][0] > r[1][1] && r[0][0] > r[2][2] )
+    {
+        const double s = 2.0 * std::sqrt( 1.0 + r[0][0] - r[1][1] - r[2][2] );
+        q[0] = ( r[2][1] - r[1][2] ) / s;
+        q[1] = 0.25 * s;
+        q[2] = ( r[0][1] + r[1][0] ) / s;
+        q[3] = ( r[0][2] + r[2][0] ) / s;
+    }
+    else if( r[1][1] > r[2][2] )
+    {
+        const double s = 2.0 * std::sqrt( 1.0 + r[1][1] - r[0][0] - r[2][2] );
+        q[0] = ( r[0][2] - r[2][0] ) / s;
+        q[1] = ( r[0][1] + r[1][0] ) / s;
+        q[2] = 0.25 * s;
+        q[3] = ( r[1][2] + r[2][1] ) / s;
+    }
+    else
+    {
+        const double s = 2.0 * std::sqrt( 1.0 + r[2][2] - r[0][0] - r[1][1] );
+        q[0] = ( r[1][0] - r[0][1] ) / s;
+        q[1] = ( r[0][2] + r[2][0] ) / s;
+        q[2] = ( r[1][2] + r[2][1] ) / s;
+        q[3] = 0.25 * s;
+    }
+    _normalize( q );
+}
+
+// Spherical interpolation of unit quaternions on the same hemisphere, also
+// extrapolating for t > 1
+void _slerp( const double* a, const double* b, const double t, double* result )
+{
+    const double cosAngle = std::min( _dot( a, b ), 1.0 );
+    double wa = 1.0 - t;
+    double wb = t;
+    if( cosAngle < 0.9999 )
+    {
+        const double angle = std::acos( cosAngle );
+        const double sinAngle = std::sin( angle );
+        wa = std::sin( ( 1.0 - t ) * angle ) / sinAngle;
+        wb = std::sin( t * angle ) / sinAngle;
+    }
+    for( size_t i = 0; i < 4; ++i )
+        result[i] = wa * a[i] + wb * b[i];
+    _normalize( result );
+}
+
+LookOut _compose( const double* translation, const double* scale,
+                  const double* q )
+{
+    const double w = q[0], x = q[1], y = q[2], z = q[3];
+    const double r[3][3] = {
+        { 1.0 - 2.0 * ( y * y + z * z ), 2.0 * ( x * y - w * z ),
+          2.0 * ( x * z + w * y ) },
+        { 2.0 * ( x * y + w * z ), 1.0 - 2.0 * ( x * x + z * z ),
+          2.0 * ( y * z - w * x ) },
+        { 2.0 * ( x * z - w * y ), 2.0 * ( y * z + w * x ),
+          1.0 - 2.0 * ( x * x + y * y ) }};
+
+    double matrix[16];
+    for( size_t col = 0; col < 3; ++col )
+    {
+        for( size_t row = 0; row < 3; ++row )
+            matrix[ col * 4 + row ] = r[row][col] * scale[col];
+        matrix[ col * 4 + 3 ] = 0.0;
+        matrix[ 12 + col ] = translation[col];
+    }
+    matrix[15] = 1.0;
+
+    LookOut lookOut;
+    lookOut.setMatrix( matrix );
+    return lookOut;
+}
+}
+
+LookOutPredictor::LookOutPredictor( const Clock::duration delay,
+                                    const Clock::duration maxExtrapolation )
+    : _delay( delay )
+    , _maxExtrapolation( maxExtrapolation )
+{
+}
+
+void LookOutPredictor::update( const LookOut& lookOut,
+                               const Clock::time_point time )
+{
+    // out of order updates restart the motion, simultaneous ones replace the
+    // latest update
+    if( _nPoses > 0 && time < _poses[1].time )
+        _nPoses = 0;
+
+    if( _nPoses == 0 )
+        _nPoses = 1;
+    else if( time > _poses[1].time )
+    {
+        _poses[0] = _poses[1];
+        _nPoses = 2;
+    }
+
+    Pose& pose = _poses[1];
+    const double* matrix = lookOut.getMatrix();
+    double rotation[3][3];
+    for( size_t col = 0; col < 3; ++col )
+    {
+        const double scale = std::sqrt( _get( matrix, 0, col ) *
+                                        _get( matrix, 0, col ) +
+                                        _get( matrix, 1, col ) *
+                                        _get( matrix, 1, col ) +
+                                        _get( matrix, 2, col ) *
+                                        _get( matrix, 2, col ));
+        pose.scale[col] = scale > 0.0 ? scale : 1.0;
+        for( size_t row = 0; row < 3; ++row )
+            rotation[row][col] = _get( matrix, row, col ) / pose.scale[col];
+        pose.translation[col] = _get( matrix, col, 3 );
+    }
+    _toQuaternion( rotation, pose.rotation );
+    pose.time = time;
+
+    // interpolate along the shortest arc
+    if( _nPoses == 2 && _dot( _poses[0].rotation, pose.rotation ) < 0.0 )
+    {
+        for( size_t i = 0; i < 4; ++i )
+            pose.rotation[i] = -pose.rotation[i];
+    }
+}
+
+void LookOutPredictor::reset()
+{
+    _nPoses = 0;
+}
+
+LookOut LookOutPredictor::predict( const Clock::time_point time ) const
+{
+    if( _nPoses == 0 )
+    {
+        const double identity[3] = { 1.0, 1.0, 1.0 };
+        const double zero[3] = { 0.0, 0.0, 0.0 };
+        const double noRotation[4] = { 1.0, 0.0, 0.0, 0.0 };
+        return _compose( zero, identity, noRotation );
+    }
+
+    const Pose& latest = _poses[1];
+    if( _nPoses == 1 )
+        return _compose( latest.translation, latest.scale, latest.rotation );
+
+    const Pose& previous = _poses[0];
+    const double interval = _interval();
+    const std::chrono::duration< double > elapsed =
+        time - _delay - previous.time;
+    const double maxExtrapolation =
+        std::chrono::duration< double >( _maxExtrapolation ).count();
+    const double t = std::min( std::max( elapsed.count() / interval, 0.0 ),
+                               1.0 + maxExtrapolation / interval );
+
+    double translation[3];
+    double scale[3];
+    double rotation[4];
+    for( size_t i = 0; i < 3; ++i )
+    {
+        translation[i] = previous.translation[i] +
+                         t * ( latest.translation[i] - previous.translation[i] );
+        scale[i] = previous.scale[i] + t * ( latest.scale[i] - previous.scale[i] );
+    }
+    _slerp( previous.rotation, latest.rotation, t, rotation );
+    return _compose( translation, scale, rotation );
+}
+
+vmml::Vector3d LookOutPredictor::getLinearVelocity() const
+{
+    if( _nPoses < 2 )
+        return vmml::Vector3d( 0.0, 0.0, 0.0 );
+
+    const double interval = _interval();
+    const double* from = _poses[0].translation;
+    const double* to = _poses[1].translation;
+    return vmml::Vector3d(( to[0] - from[0] ) / interval,
+                          ( to[1] - from[1] ) / interval,
+                          ( to[2] - from[2] ) / interval );
+}
+
+vmml::Vector3d LookOutPredictor::getAngularVelocity() const
+{
+    if( _nPoses < 2 )
+        return vmml::Vector3d( 0.0, 0.0, 0.0 );
+
+    // delta rotation q1 * conjugate( q0 ) in world space
+    const double* a = _poses[0].rotation;
+    const double* b = _poses[1].rotation;
+    const double w = b[0] * a[0] + b[1] * a[1] + b[2] * a[2] + b[3] * a[3];
+    const double x = -b[0] * a[1] + b[1] * a[0] - b[2] * a[3] + b[3] * a[2];
+    const double y = -b[0] * a[2] + b[1] * a[3] + b[2] * a[0] - b[3] * a[1];
+    const double z = -b[0] * a[3] - b[1] * a[2] + b[2] * a[1] + b[3] * a[0];
+
+    const double sinHalfAngle = std::sqrt( x * x + y * y + z * z );
+    if( sinHalfAngle < 1e-12 )
+        return vmml::Vector3d( 0.0, 0.0, 0.0 );
+
+    const double angle = 2.0 * std::atan2( sinHalfAngle, w );
+    const double factor = angle / sinHalfAngle / _interval();
+    return vmml::Vector3d( x * factor, y * factor, z * factor );
+}
+
+double LookOutPredictor::_interval() const
+{
+    return std::chrono::duration< double >( _poses[1].time -
+                                            _poses[0].time ).count();
+}
+
+}
+}
@@ -0,0 +1,90 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#pragma once
+
+#include <lexis/api.h>
+#include <lexis/render/lookOut.h>
+#include <vmmlib/types.hpp>
+
+#include <chrono>
+
+namespace lexis
+{
+namespace render
+{
+
+/**
+ * Smooth LookOut motion on the receiving side of a low-rate LookOut stream.
+ *
+ * Each matrix is decomposed into translation, rotation and scale. Between two
+ * updates the motion is interpolated (linearly for the translation, spherically
+ * for the rotation), after the latest update it is extrapolated with the linear
+ * and angular velocity of the last two updates for a limited time. The matrices
+ * are expected to be affine without shear, as any camera transformation.
+ *
+ * Publishers may then send LookOut events at a fixed low rate while receivers
+ * render at full frame rate. To render without extrapolation errors, delay the
+ * prediction by one publish period.
+ */
+class LookOutPredictor
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @param delay the time the prediction lags behind the requested time
+     * @param maxExtrapolation the maximum time the motion is extrapolated
+     *                         beyond the latest update
+     */
+    LEXIS_API explicit LookOutPredictor(
+        Clock::duration delay = Clock::duration::zero(),
+        Clock::duration maxExtrapolation = std::chrono::milliseconds( 250 ));
+
+    /**
+     * Add an update of the LookOut.
+     *
+     * @param lookOut the received LookOut
+     * @param time the time of the update, ideally when it was published
+     */
+    LEXIS_API void update( const LookOut& lookOut,
+                           Clock::time_point time = Clock::now( ));
+
+    /** Forget all updates, the next update is not interpolated. */
+    LEXIS_API void reset();
+
+    /**
+     * @param time the time to predict the LookOut for
+     * @return the predicted LookOut, the identity if no update was received.
+     */
+    LEXIS_API LookOut predict( Clock::time_point time = Clock::now( )) const;
+
+    /** @return the linear velocity between the last two updates in m/s. */
+    LEXIS_API vmml::Vector3d getLinearVelocity() const;
+
+    /**
+     * @return the angular velocity between the last two updates as rotation
+     *         axis scaled by the angle in rad/s.
+     */
+    LEXIS_API vmml::Vector3d getAngularVelocity() const;
+
+private:
+    struct Pose
+    {
+        Clock::time_point time;
+        double translation[3];
+        double scale[3];
+        double rotation[4]; // quaternion w, x, y, z
+    };
+
+    const Clock::duration _delay;
+    const Clock::duration _maxExtrapolation;
+    Pose _poses[2]; // previous and latest update
+    size_t _nPoses = 0;
+
+    double _interval() const;
+};
+
+}
+}
@@ -0,0 +1,626 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#include "MaterialLUT.h"
+
+#include <lexis/detail/patch.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#ifdef __SSE__
+#  include <xmmintrin.h>
+#endif
+#ifdef __SSE2__
+#  include <emmintrin.h>
+#endif
+
+namespace lexis
+{
+namespace render
+{
+namespace
+{
+typedef std::vector< detail::Color > Colors;
+typedef std::vector< float > Floats;
+
+using lexis::detail::diffRange;
+using lexis::detail::patchRange;
+
+// Positions of the output entries [begin, end) in a source channel, shared by
+// all channels of the same size so the interpolation loops are branch-free.
+struct Samples
+{
+    Samples( const size_t sourceSize, const size_t size, const size_t begin,
+             const size_t end )
+        : index( end - begin )
+        , weight( end - begin )
+    {
+        if( sourceSize < 2 || size < 2 )
+            return;
+
+        const float scale = float( sourceSize - 1 ) / float( size - 1 );
+        const uint32_t last = uint32_t( sourceSize - 2 );
+        for( size_t i = 0; i < end - begin; ++i )
+        {
+            const float x = float( begin + i ) * scale;
+            index[i] = std::min( uint32_t( x ), last );
+            weight[i] = x - float( index[i] );
+        }
+    }
+
+    std::vector< uint32_t > index;
+    std::vector< float > weight;
+};
+
+// Resamples the red, green, blue and alpha channels to the entries
+// [begin, end) of a texture of size entries, interpolating the four channels of
+// an entry at once. Empty channels are filled with fallback.
+void _resample( Floats ( &channels )[4], const float ( &fallback )[4],
+                const size_t size, const size_t begin, const size_t end,
+                float* rgba )
+{
+    // constant channels interpolate between two equal entries
+    for( size_t i = 0; i < 4; ++i )
+    {
+        Floats& channel = channels[i];
+        if( channel.empty( ))
+            channel.push_back( fallback[i] );
+        if( channel.size() == 1 )
+            channel.push_back( channel[0] );
+    }
+
+    const Samples samples[4] = {
+        Samples( channels[0].size(), size, begin, end ),
+        Samples( channels[1].size(), size, begin, end ),
+        Samples( channels[2].size(), size, begin, end ),
+        Samples( channels[3].size(), size, begin, end ) };
+    const float* values[4];
+    const uint32_t* index[4];
+    const float* weight[4];
+    for( size_t i = 0; i < 4; ++i )
+    {
+        values[i] = channels[i].data();
+        index[i] = samples[i].index.data();
+        weight[i] = samples[i].weight.data();
+    }
+
+    rgba += 4 * begin;
+    for( size_t i = 0; i < end - begin; ++i )
+    {
+#ifdef __SSE__
+        const __m128 a = _mm_setr_ps( values[0][ index[0][i] ],
+                                      values[1][ index[1][i] ],
+                                      values[2][ index[2][i] ],
+                                      values[3][ index[3][i] ] );
+        const __m128 b = _mm_setr_ps( values[0][ index[0][i] + 1 ],
+                                      values[1][ index[1][i] + 1 ],
+                                      values[2][ index[2][i] + 1 ],
+                                      values[3][ index[3][i] + 1 ] );
+        const __m128 t = _mm_setr_ps( weight[0][i], weight[1][i], weight[2][i],
+                                      weight[3][i] );
+        _mm_storeu_ps( rgba + 4 * i,
+                       _mm_add_ps( a, _mm_mul_ps( t, _mm_sub_ps( b, a ))));
+#else
+        for( size_t j = 0; j < 4; ++j )
+        {
+            const float a = values[j][ index[j][i] ];
+            const float b = values[j][ index[j][i] + 1 ];
+            rgba[ 4 * i + j ] = a + weight[j][i] * ( b - a );
+        }
+#endif
+    }
+}
+
+void _toRGBA8( const float* in, const size_t count, uint8_t* out )
+{
+    for( size_t i = 0; i < count; ++i )
+        out[i] = uint8_t( std::min( std::max( in[i], 0.f ), 1.f ) * 255.f +
+                          0.5f );
+}
+
+template< class C >
+void _split( const C& colors, Floats& red, Floats& green, Floats& blue )
+{
+    red.clear();
+    green.clear();
+    blue.clear();
+    for( const auto& color : colors )
+    {
+        red.push_back( color.getRed( ));
+        green.push_back( color.getGreen( ));
+        blue.push_back( color.getBlue( ));
+    }
+}
+
+template< class T = float, class V > std::vector< T > _copy( const V& values )
+{
+    return std::vector< T >( values.begin(), values.end( ));
+}
+
+// Changed entries [start, end) of a LUT channel
+struct Change
+{
+    size_t start = 0;
+    size_t end = 0;
+    bool resized = false;
+};
+
+// Patches a channel and records the changed entries
+template< class T >
+bool _patch( std::vector< T >& values, const size_t size, const size_t start,
+             const std::vector< T >& replacement, Change& change )
+{
+    const bool resized = size != values.size();
+    if( !patchRange( values, size, start, replacement ))
+        return false;
+
+    change.start = start;
+    change.end = start + replacement.size();
+    change.resized = resized;
+    return true;
+}
+
+// Extends [begin, end) by the texture entries resampled from changed entries
+// of a channel with channelSize entries
+void _extend( const Change& change, const size_t channelSize,
+              const size_t size, size_t& begin, size_t& end )
+{
+    if( change.start == change.end )
+        return;
+    if( channelSize < 2 || size < 2 )
+    {
+        begin = 0;
+        end = size;
+        return;
+    }
+
+    // texture entry i interpolates the channel entries floor( i * scale ) and
+    // the next one; widened by one entry against rounding differences
+    const double scale = double( channelSize - 1 ) / double( size - 1 );
+    const double first = change.start > 0 ?
+                             double( change.start - 1 ) / scale : 0.0;
+    const size_t last = size_t( double( change.end ) / scale ) + 2;
+    begin = std::min( begin, first > 1.0 ? size_t( first ) - 1 : 0 );
+    end = std::max( end, std::min( last, size ));
+}
+
+const size_t _minValuesPerThread = 1 << 16;
+
+#ifdef __SSE2__
+__m128 _load4( const float* values )
+{
+    return _mm_loadu_ps( values );
+}
+
+__m128 _load4( const uint16_t* values )
+{
+    const __m128i packed =
+        _mm_loadl_epi64( reinterpret_cast< const __m128i* >( values ));
+    return _mm_cvtepi32_ps( _mm_unpacklo_epi16( packed, _mm_setzero_si128( )));
+}
+#endif
+
+// Maps values to LUT positions and writes the looked up RGBA entries to out
+template< class T >
+void _lookup( const T* values, const size_t count, const float* lut,
+              const size_t lutSize, const float offset, const float scale,
+              const MaterialLUT::Interpolation interpolation, float* out )
+{
+    const bool nearest =
+        interpolation == MaterialLUT::Interpolation::nearest || lutSize < 2;
+    const float last = float( lutSize - 1 );
+    size_t i = 0;
+
+#ifdef __SSE2__
+    // four values per iteration, positions, indices and weights in registers
+    const __m128 offset4 = _mm_set1_ps( offset );
+    const __m128 scale4 = _mm_set1_ps( scale );
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 last4 = _mm_set1_ps( last );
+    alignas( 16 ) int32_t index[4];
+    alignas( 16 ) float weight[4];
+    if( nearest )
+    {
+        const __m128 half = _mm_set1_ps( 0.5f );
+        for( ; i + 4 <= count; i += 4 )
+        {
+            // max returns its second operand for NaN, which clamps NaN to 0
+            __m128 x = _mm_mul_ps( _mm_sub_ps( _load4( values + i ), offset4 ),
+                                   scale4 );
+            x = _mm_min_ps( _mm_max_ps( x, zero ), last4 );
+            _mm_store_si128( reinterpret_cast< __m128i* >( index ),
+                             _mm_cvttps_epi32( _mm_add_ps( x, half )));
+            for( size_t j = 0; j < 4; ++j )
+                _mm_storeu_ps( out + 4 * ( i + j ),
+                               _mm_loadu_ps( lut + 4 * index[j] ));
+        }
+    }
+    else
+    {
+        const __m128 lastIndex4 = _mm_set1_ps( last - 1.f );
+        for( ; i + 4 <= count; i += 4 )
+        {
+            __m128 x = _mm_mul_ps( _mm_sub_ps( _load4( values + i ), offset4 ),
+                                   scale4 );
+            x = _mm_min_ps( _mm_max_ps( x, zero ), last4 );
+            const __m128i first =
+                _mm_cvttps_epi32( _mm_min_ps( x, lastIndex4 ));
+            _mm_store_si128( reinterpret_cast< __m128i* >( index ), first );
+            _mm_store_ps( weight, _mm_sub_ps( x, _mm_cvtepi32_ps( first )));
+            for( size_t j = 0; j < 4; ++j )
+            {
+                const __m128 a = _mm_loadu_ps( lut + 4 * index[j] );
+                const __m128 b = _mm_loadu_ps( lut + 4 * index[j] + 4 );
+                const __m128 t = _mm_set1_ps( weight[j] );
+                const __m128 color =
+                    _mm_add_ps( a, _mm_mul_ps( t, _mm_sub_ps( b, a )));
+                _mm_storeu_ps( out + 4 * ( i + j ), color );
+            }
+        }
+    }
+#endif
+
+    if( nearest )
+    {
+        for( ; i < count; ++i )
+        {
+            float x = ( float( values[i] ) - offset ) * scale;
+            x = x > 0.f ? std::min( x, last ) : 0.f; // also clamps NaN
+            const float* entry = lut + 4 * size_t( x + 0.5f );
+            out[ 4 * i ] = entry[0];
+            out[ 4 * i + 1 ] = entry[1];
+            out[ 4 * i + 2 ] = entry[2];
+            out[ 4 * i + 3 ] = entry[3];
+        }
+        return;
+    }
+
+    const size_t lastIndex = lutSize - 2;
+    for( ; i < count; ++i )
+    {
+        float x = ( float( values[i] ) - offset ) * scale;
+        x = x > 0.f ? std::min( x, last ) : 0.f;
+        const size_t first = std::min( size_t( x ), lastIndex );
+        const float t = x - float( first );
+        const float* a = lut + 4 * first;
+        const float* b = a + 4;
+        out[ 4 * i ] = a[0] + t * ( b[0] - a[0] );
+        out[ 4 * i + 1 ] = a[1] + t * ( b[1] - a[1] );
+        out[ 4 * i + 2 ] = a[2] + t * ( b[2] - a[2] );
+        out[ 4 * i + 3 ] = a[3] + t * ( b[3] - a[3] );
+    }
+}
+
+// Threads classifying chunks of large arrays together with the calling thread,
+// started on first use and kept for the lifetime of the process
+class Workers
+{
+public:
+    using Func = std::function< void( size_t, size_t ) >;
+
+    static Workers& get()
+    {
+        static Workers workers;
+        return workers;
+    }
+
+    size_t getSize() const { return _threads.size() + 1; }
+
+    // Calls func( begin, end ) for nChunks chunks of [0, count) and returns
+    // when all are done. Concurrent callers are served one after the other.
+    void run( const size_t count, const size_t nChunks, const Func& func )
+    {
+        std::lock_guard< std::mutex > runLock( _runMutex );
+        std::unique_lock< std::mutex > lock( _mutex );
+        _func = &func;
+        _count = count;
+        _nChunks = nChunks;
+        _next = 0;
+        _done = 0;
+        _start.notify_all();
+
+        _work( lock );
+        _finished.wait( lock, [this] { return _done == _nChunks; });
+        _func = nullptr;
+        _nChunks = 0;
+        _next = 0;
+    }
+
+private:
+    Workers()
+    {
+        const size_t nCores =
+            std::max( std::thread::hardware_concurrency(), 1u );
+        for( size_t i = 1; i < nCores; ++i )
+            _threads.emplace_back( [this] { _run(); } );
+    }
+
+    ~Workers()
+    {
+        {
+            std::lock_guard< std::mutex > lock( _mutex );
+            _stopping = true;
+        }
+        _start.notify_all();
+        for( auto& thread : _threads )
+            thread.join();
+    }
+
+    void _run()
+    {
+        std::unique_lock< std::mutex > lock( _mutex );
+        while( true )
+        {
+            _start.wait( lock,
+                         [this] { return _stopping || _next < _nChunks; });
+            if( _stopping )
+                return;
+            _work( lock );
+        }
+    }
+
+    // Processes chunks of the current job until none is left, lock is held
+    // except while processing
+    void _work( std::unique_lock< std::mutex >& lock )
+    {
+        const size_t chunk = ( _count + _nChunks - 1 ) / _nChunks;
+        while( _next < _nChunks )
+        {
+            const size_t i = _next++;
+            const Func& func = *_func;
+            const size_t begin = std::min( i * chunk, _count );
+            const size_t end = std::min(( i + 1 ) * chunk, _count );
+            lock.unlock();
+            func( begin, end );
+            lock.lock();
+            if( ++_done == _nChunks )
+                _finished.notify_all();
+        }
+    }
+
+    std::vector< std::thread > _threads;
+    std::mutex _runMutex; // serializes run()
+    std::mutex _mutex;    // protects all members below
+    std::condition_variable _start;
+    std::condition_variable _finished;
+    const Func* _func = nullptr;
+    size_t _count = 0;
+    size_t _nChunks = 0;
+    size_t _next = 0; // the next chunk to process
+    size_t _done = 0; // the number of processed chunks
+    bool _stopping = false;
+};
+
+// Calls func( begin, end ) for chunks of [0, count) on multiple threads
+template< class F > void _parallelFor( const size_t count, const F& func )
+{
+    if( count < 2 * _minValuesPerThread )
+    {
+        func( 0, count );
+        return;
+    }
+
+    Workers& workers = Workers::get();
+    const size_t nChunks = std::min( workers.getSize(),
+                                     count / _minValuesPerThread );
+    if( nChunks < 2 )
+        func( 0, count );
+    else
+        workers.run( count, nChunks, func );
+}
+}
+
+const std::vector< float >&
+MaterialLUT::getTexture( const size_t size, const Texture texture ) const
+{
+    return _bake( _baked[ size_t( texture ) ], size, texture, false ).rgba;
+}
+
+const std::vector< uint8_t >&
+MaterialLUT::getTexture8( const size_t size, const Texture texture ) const
+{
+    return _bake( _baked[ size_t( texture ) ], size, texture, true ).rgba8;
+}
+
+void MaterialLUT::classify( const float* values, const size_t count,
+                            float* rgba, float* emission,
+                            const Interpolation interpolation ) const
+{
+    _classify( values, count, rgba, emission, interpolation );
+}
+
+void MaterialLUT::classify( const uint16_t* values, const size_t count,
+                            float* rgba, float* emission,
+                            const Interpolation interpolation ) const
+{
+    _classify( values, count, rgba, emission, interpolation );
+}
+
+template< class T >
+void MaterialLUT::_classify( const T* values, const size_t count, float* rgba,
+                             float* emission,
+                             const Interpolation interpolation ) const
+{
+    const size_t lutSize = std::max( { size_t( 1 ), getDiffuse().size(),
+                                       getEmission().size(), getAlpha().size(),
+                                       getContribution().size() } );
+
+    // bake both textures before any thread reads them
+    const float* diffuseLUT = _bake( _classified[0], lutSize,
+                                     Texture::diffuseAlpha, false ).rgba.data();
+    const float* emissionLUT = emission ?
+        _bake( _classified[1], lutSize, Texture::emissionContribution,
+               false ).rgba.data() : nullptr;
+
+    const double* range = getRange();
+    const double width = range[1] - range[0];
+    const float offset = float( range[0] );
+    const float scale = width > 0.0 ? float( double( lutSize - 1 ) / width )
+                                    : 0.f;
+
+    _parallelFor( count, [&]( const size_t begin, const size_t end )
+    {
+        _lookup( values + begin, end - begin, diffuseLUT, lutSize, offset,
+                 scale, interpolation, rgba + 4 * begin );
+        if( emission )
+            _lookup( values + begin, end - begin, emissionLUT, lutSize, offset,
+                     scale, interpolation, emission + 4 * begin );
+    });
+}
+
+const MaterialLUT::Baked& MaterialLUT::_bake( Baked& baked, const size_t size,
+                                              const Texture texture,
+                                              const bool rgba8 ) const
+{
+    if( _bakedLUT != *this )
+    {
+        _bakedLUT = *this;
+        for( size_t i = 0; i < 2; ++i )
+            _baked[i].size = _classified[i].size = 0;
+    }
+
+    if( baked.size != size || baked.rgba.size() != 4 * size )
+    {
+        baked.rgba.resize( 4 * size );
+        baked.rgba8.clear();
+        baked.size = size;
+        _rebake( baked, texture, 0, size );
+    }
+
+    if( rgba8 && baked.rgba8.size() != baked.rgba.size( ))
+    {
+        baked.rgba8.resize( baked.rgba.size( ));
+        _toRGBA8( baked.rgba.data(), baked.rgba.size(), baked.rgba8.data( ));
+    }
+    return baked;
+}
+
+void MaterialLUT::_rebake( Baked& baked, const Texture texture,
+                           const size_t begin, const size_t end ) const
+{
+    Floats channels[4];
+    if( texture == Texture::diffuseAlpha )
+    {
+        _split( getDiffuse(), channels[0], channels[1], channels[2] );
+        channels[3] = _copy( getAlpha( ));
+    }
+    else
+    {
+        _split( getEmission(), channels[0], channels[1], channels[2] );
+        channels[3] = _copy( getContribution( ));
+    }
+
+    const float fallback[4] = { 0.f, 0.f, 0.f,
+                                texture == Texture::diffuseAlpha ? 1.f : 0.f };
+    float* rgba = baked.rgba.data();
+    _resample( channels, fallback, baked.size, begin, end, rgba );
+
+    if( !baked.rgba8.empty( ))
+        _toRGBA8( rgba + 4 * begin, 4 * ( end - begin ),
+                  baked.rgba8.data() + 4 * begin );
+}
+
+MaterialLUTPatch MaterialLUT::diff( const MaterialLUT& base ) const
+{
+    MaterialLUTPatch patch;
+    patch.setBaseVersion( base.getVersion( ));
+    patch.setVersion( getVersion( ));
+    double range[2] = { getRange()[0], getRange()[1] };
+    patch.setRange( range );
+
+    uint32_t start = 0;
+    const Colors diffuse = _copy< detail::Color >( getDiffuse( ));
+    patch.setDiffuse( diffRange( _copy< detail::Color >( base.getDiffuse( )),
+                                 diffuse, start ));
+    patch.setDiffuseStart( start );
+    patch.setDiffuseSize( uint32_t( diffuse.size( )));
+
+    const Colors emission = _copy< detail::Color >( getEmission( ));
+    patch.setEmission( diffRange( _copy< detail::Color >( base.getEmission( )),
+                                  emission, start ));
+    patch.setEmissionStart( start );
+    patch.setEmissionSize( uint32_t( emission.size( )));
+
+    const Floats alpha = _copy( getAlpha( ));
+    patch.setAlpha( diffRange( _copy( base.getAlpha( )), alpha, start ));
+    patch.setAlphaStart( start );
+    patch.setAlphaSize( uint32_t( alpha.size( )));
+
+    const Floats contribution = _copy( getContribution( ));
+    patch.setContribution( diffRange( _copy( base.getContribution( )),
+                                      contribution, start ));
+    patch.setContributionStart( start );
+    patch.setContributionSize( uint32_t( contribution.size( )));
+    return patch;
+}
+
+bool MaterialLUT::apply( const MaterialLUTPatch& patch )
+{
+    if( patch.getBaseVersion() != getVersion( ))
+        return false;
+
+    // the channels of each texture: diffuse, alpha, emission, contribution
+    Change changes[4];
+    Colors diffuse = _copy< detail::Color >( getDiffuse( ));
+    Colors emission = _copy< detail::Color >( getEmission( ));
+    Floats alpha = _copy( getAlpha( ));
+    Floats contribution = _copy( getContribution( ));
+    if( !_patch( diffuse, patch.getDiffuseSize(), patch.getDiffuseStart(),
+                 _copy< detail::Color >( patch.getDiffuse( )), changes[0] ) ||
+        !_patch( alpha, patch.getAlphaSize(), patch.getAlphaStart(),
+                 _copy( patch.getAlpha( )), changes[1] ) ||
+        !_patch( emission, patch.getEmissionSize(), patch.getEmissionStart(),
+                 _copy< detail::Color >( patch.getEmission( )), changes[2] ) ||
+        !_patch( contribution, patch.getContributionSize(),
+                 patch.getContributionStart(),
+                 _copy( patch.getContribution( )), changes[3] ))
+    {
+        return false;
+    }
+
+    const bool cached = _bakedLUT == *this;
+    double range[2] = { patch.getRange()[0], patch.getRange()[1] };
+    setRange( range );
+    setDiffuse( diffuse );
+    setEmission( emission );
+    setAlpha( alpha );
+    setContribution( contribution );
+    setVersion( patch.getVersion( ));
+    if( !cached )
+        return true;
+
+    // update the baked textures in place instead of rebaking them on next use
+    _bakedLUT = *this;
+    const size_t sizes[4] = { diffuse.size(), alpha.size(), emission.size(),
+                              contribution.size() };
+    for( size_t i = 0; i < 4; ++i )
+    {
+        const size_t texture = i % 2;
+        Baked& baked = i < 2 ? _baked[ texture ] : _classified[ texture ];
+        const Change& color = changes[ 2 * texture ];
+        const Change& opacity = changes[ 2 * texture + 1 ];
+        if( baked.size == 0 )
+            continue;
+        if( color.resized || opacity.resized )
+        {
+            baked.size = 0;
+            continue;
+        }
+
+        size_t begin = baked.size;
+        size_t end = 0;
+        _extend( color, sizes[ 2 * texture ], baked.size, begin, end );
+        _extend( opacity, sizes[ 2 * texture + 1 ], baked.size, begin, end );
+        if( begin < end )
+            _rebake( baked, Texture( texture ), begin, end );
+    }
+    return true;
+}
+
+}
+}
@@ -0,0 +1,133 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#pragma once
+
+#include <lexis/api.h>
+#include <lexis/render/detail/materialLUT.h> // base class
+
+#include <vector>
+
+namespace lexis
+{
+namespace render
+{
+
+using MaterialLUTPatch = detail::MaterialLUTPatch;
+
+/**
+ * Material lookup table with cached, renderer-ready texture representations.
+ *
+ * The textures are resampled from the LUT channels and cached until the content
+ * of the LUT changes. Requesting them every frame only costs a comparison of
+ * the LUT with the content the textures were baked of, a changed LUT is copied
+ * once for this comparison. The textures used by classify() are cached
+ * separately and do not evict the last requested texture of each type. Empty
+ * channels are filled with zero, except alpha which is filled with one. The
+ * texture accessors are not thread safe.
+ */
+class MaterialLUT : public detail::MaterialLUT
+{
+public:
+    /** The channels interleaved into an RGBA texture. */
+    enum class Texture
+    {
+        diffuseAlpha,        //!< diffuse color and alpha
+        emissionContribution //!< emission color and contribution
+    };
+
+    /** The lookup of values between two LUT entries in classify(). */
+    enum class Interpolation
+    {
+        nearest, //!< use the closest LUT entry
+        linear   //!< interpolate linearly between the two closest entries
+    };
+
+    /**
+     * @param size the number of RGBA entries of the texture
+     * @param texture the channels to interleave
+     * @return the interleaved RGBA texture with 4 * size floats in [0..1].
+     */
+    LEXIS_API const std::vector< float >&
+    getTexture( size_t size, Texture texture = Texture::diffuseAlpha ) const;
+
+    /**
+     * @param size the number of RGBA entries of the texture
+     * @param texture the channels to interleave
+     * @return the interleaved RGBA texture with 4 * size bytes in [0..255].
+     */
+    LEXIS_API const std::vector< uint8_t >&
+    getTexture8( size_t size, Texture texture = Texture::diffuseAlpha ) const;
+
+    /**
+     * Map scalar values to RGBA through the LUT.
+     *
+     * The values are mapped from getRange() to the LUT entries, values outside
+     * of the range are clamped to the first or last entry. The LUT is sampled
+     * at the size of its largest channel. Large arrays are classified in
+     * parallel by worker threads on all available cores, which are shared by
+     * all LUTs and started on first use.
+     *
+     * Not thread safe, the textures used for the lookup are baked on demand
+     * like by getTexture().
+     *
+     * @param values the scalar values to classify
+     * @param count the number of values
+     * @param rgba output of 4 * count floats of diffuse color and alpha
+     * @param emission optional output of 4 * count floats of emission color and
+     *                 contribution, may be nullptr
+     * @param interpolation the lookup mode between LUT entries
+     */
+    LEXIS_API void classify( const float* values, size_t count, float* rgba,
+                             float* emission = nullptr,
+                             Interpolation interpolation =
+                                 Interpolation::linear ) const;
+
+    /** @overload */
+    LEXIS_API void classify( const uint16_t* values, size_t count, float* rgba,
+                             float* emission = nullptr,
+                             Interpolation interpolation =
+                                 Interpolation::linear ) const;
+
+    /**
+     * @param base the LUT known to the receiver
+     * @return the patch replacing the entries which differ from base.
+     */
+    LEXIS_API MaterialLUTPatch diff( const MaterialLUT& base ) const;
+
+    /**
+     * Apply a patch in place.
+     *
+     * Cached textures are updated incrementally, only the texture entries
+     * depending on changed LUT entries are resampled.
+     *
+     * @return false if the patch does not apply to the version of this LUT, it
+     *         is left unchanged then.
+     */
+    LEXIS_API bool apply( const MaterialLUTPatch& patch );
+
+private:
+    struct Baked
+    {
+        size_t size = 0;
+        std::vector< float > rgba;
+        std::vector< uint8_t > rgba8;
+    };
+
+    mutable detail::MaterialLUT _bakedLUT; // content the textures are baked of
+    mutable Baked _baked[ 2 ];      // by Texture for getTexture()
+    mutable Baked _classified[ 2 ]; // by Texture at the size used by classify()
+
+    const Baked& _bake( Baked& baked, size_t size, Texture texture,
+                        bool rgba8 ) const;
+    void _rebake( Baked& baked, Texture texture, size_t begin,
+                  size_t end ) const;
+
+    template< class T >
+    void _classify( const T* values, size_t count, float* rgba,
+                    float* emission, Interpolation interpolation ) const;
+};
+
+}
+}
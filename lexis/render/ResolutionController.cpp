@@ -0,0 +1,99 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#include "ResolutionController.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace lexis
+{
+namespace render
+{
+namespace
+{
+// Weight of the latest frame time in the smoothed frame time
+const double _smoothing = 0.3;
+
+// Band around the target frame time in which the scale is kept
+const double _lowerBound = 0.7;
+const double _upperBound = 1.1;
+
+// The target of an increase, to not exceed the upper bound right away
+const double _increaseTarget = 0.9;
+const float _maxIncrease = 1.25f;
+
+// Scales are multiples of this step to avoid many viewport size changes
+const float _scaleStep = 1.f / 32.f;
+}
+
+ResolutionController::ResolutionController(
+    const Clock::duration targetFrameTime )
+    : _targetFrameTime( targetFrameTime )
+{
+}
+
+void ResolutionController::setScaleRange( const float minScale,
+                                          const float maxScale )
+{
+    _minScale = std::min( minScale, maxScale );
+    _maxScale = std::max( minScale, maxScale );
+    _scale = std::min( std::max( _scale, _minScale ), _maxScale );
+}
+
+Viewport ResolutionController::getRenderViewport() const
+{
+    const float scale = getScale();
+    const uint32_t* size = _viewport.getSize();
+    uint32_t renderSize[2];
+    for( size_t i = 0; i < 2; ++i )
+        renderSize[i] = size[i] == 0 ? 0 : std::max( uint32_t(
+                            std::lround( float( size[i] ) * scale )), 1u );
+
+    Viewport viewport;
+    viewport.setSize( renderSize );
+    return viewport;
+}
+
+bool ResolutionController::update( const Clock::duration frameTime,
+                                   const bool interacting )
+{
+    const float oldScale = getScale();
+
+    // the last frame was rendered with the old scale, convert its time to the
+    // interactive scale
+    const double ratio = double( _scale ) / double( oldScale );
+    const double time =
+        std::chrono::duration< double >( frameTime ).count() * ratio * ratio;
+    _frameTime = _frameTime > 0.0 ?
+                     _frameTime + _smoothing * ( time - _frameTime ) : time;
+    _interacting = interacting;
+    if( !interacting )
+        return getScale() != oldScale;
+
+    const double target =
+        std::chrono::duration< double >( _targetFrameTime ).count();
+    float scale = _scale;
+    if( _frameTime > _upperBound * target )
+        scale = float( _scale * std::sqrt( target / _frameTime ));
+    else if( _frameTime < _lowerBound * target && _scale < _maxScale )
+    {
+        scale = float( _scale *
+                       std::sqrt( _increaseTarget * target / _frameTime ));
+        scale = std::min( scale, _scale * _maxIncrease );
+    }
+
+    scale = std::floor( scale / _scaleStep ) * _scaleStep;
+    scale = std::min( std::max( scale, _minScale ), _maxScale );
+    if( scale != _scale )
+    {
+        // predict the frame time at the new scale until measured
+        _frameTime *= double( scale ) * scale / ( double( _scale ) * _scale );
+        _scale = scale;
+    }
+    return getScale() != oldScale;
+}
+
+}
+}
@@ -0,0 +1,87 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#pragma once
+
+#include <lexis/api.h>
+#include <lexis/render/viewport.h>
+
+#include <chrono>
+
+namespace lexis
+{
+namespace render
+{
+
+/**
+ * Dynamic resolution scaling to keep the frame time of a renderer below a
+ * target during interaction.
+ *
+ * From the measured frame times, the controller derives the render viewport as
+ * the display viewport scaled in both dimensions, assuming the frame time is
+ * proportional to the number of pixels. The frame time is smoothed and the
+ * scale only changes when it leaves a band around the target, so it does not
+ * oscillate with small variations. When the interaction stops, for instance
+ * when the camera does not move, the next frame is rendered at maximum scale
+ * while the interactive scale is kept for the next interaction.
+ */
+class ResolutionController
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /** @param targetFrameTime the frame time to stay below during interaction */
+    LEXIS_API explicit ResolutionController(
+        Clock::duration targetFrameTime = std::chrono::milliseconds( 33 ));
+
+    /** Set the frame time to stay below during interaction. */
+    void setTargetFrameTime( const Clock::duration frameTime )
+        { _targetFrameTime = frameTime; }
+
+    /** @return the frame time to stay below during interaction. */
+    Clock::duration getTargetFrameTime() const { return _targetFrameTime; }
+
+    /**
+     * Set the range of the scale of the render viewport, [0.25, 1] by default.
+     */
+    LEXIS_API void setScaleRange( float minScale, float maxScale );
+
+    float getMinScale() const { return _minScale; }
+    float getMaxScale() const { return _maxScale; }
+
+    /** Set the display viewport the render viewport is derived from. */
+    void setViewport( const Viewport& viewport ) { _viewport = viewport; }
+
+    /** @return the display viewport. */
+    const Viewport& getViewport() const { return _viewport; }
+
+    /** @return the current scale of the render viewport. */
+    float getScale() const { return _interacting ? _scale : _maxScale; }
+
+    /** @return the viewport to render the next frame with. */
+    LEXIS_API Viewport getRenderViewport() const;
+
+    /**
+     * Update the scale with the time of the last frame.
+     *
+     * @param frameTime the time to render the last frame with the render
+     *                  viewport
+     * @param interacting false if the view did not change since the last frame,
+     *                    the next frame is rendered at maximum scale then
+     * @return true if the render viewport has changed.
+     */
+    LEXIS_API bool update( Clock::duration frameTime, bool interacting = true );
+
+private:
+    Clock::duration _targetFrameTime;
+    float _minScale = 0.25f;
+    float _maxScale = 1.f;
+    Viewport _viewport;
+    float _scale = 1.f; // interactive scale
+    double _frameTime = 0.0; // smoothed frame time at interactive scale
+    bool _interacting = true;
+};
+
+}
+}
@@ -0,0 +1,127 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#include "StreamController.h"
+
+#include <algorithm>
+
+namespace lexis
+{
+namespace render
+{
+namespace
+{
+// Consecutive updates meeting the target before the quality is increased
+const size_t _increaseDelay = 3;
+const uint16_t _qualityStep = 5;
+
+// Typical size ratio of uncompressed to JPEG compressed frames
+const double _compressionRatio = 10.0;
+
+// Updates without overload before an uncompressed stream is tried again
+const size_t _retryDelay = 100;
+}
+
+StreamController::StreamController( const double targetFPS )
+    : _targetFPS( targetFPS )
+{
+}
+
+void StreamController::setTargetFPS( const double fps )
+{
+    _targetFPS = fps;
+    _nGood = 0;
+    _uncompressedFailed = false;
+}
+
+void StreamController::setMaxBandwidth( const double bandwidth )
+{
+    _maxBandwidth = bandwidth;
+    _uncompressedFailed = false;
+}
+
+void StreamController::setQualityRange( const uint16_t minQuality,
+                                        const uint16_t maxQuality )
+{
+    _minQuality = std::min( minQuality, maxQuality );
+    _maxQuality = std::max( minQuality, maxQuality );
+}
+
+bool StreamController::update( const StreamFeedback& feedback, Stream& stream )
+{
+    if( _targetFPS <= 0.0 )
+        return false;
+
+    const double frameTime = 1.0 / _targetFPS;
+    const double frameRate = feedback.getFrameRate();
+    const double bandwidth = feedback.getBandwidth();
+    const double decodeTime = feedback.getDecodeTime();
+
+    // A low frame rate with short latency and decode time is caused by the
+    // sender, which a lower quality does not help.
+    const bool streamLimited = feedback.getLatency() > frameTime ||
+                               decodeTime > 0.5 * frameTime;
+    const bool overloaded =
+        ( frameRate < 0.95 * _targetFPS && streamLimited ) ||
+        feedback.getLatency() > 2.0 * frameTime;
+
+    // Decoding takes longer than the transport. A lower JPEG quality barely
+    // shortens the decode time, sending uncompressed frames does if they fit.
+    const bool decodeLimited = decodeTime > 0.5 * frameTime &&
+                               decodeTime >= feedback.getLatency() - decodeTime;
+
+    // a transient congestion does not rule out an uncompressed stream for good
+    if( overloaded )
+        _nRetry = 0;
+    else if( _uncompressedFailed && ++_nRetry >= _retryDelay )
+        _uncompressedFailed = false;
+    const bool canUncompress = !_uncompressedFailed && _maxBandwidth > 0.0 &&
+                               bandwidth * _compressionRatio < _maxBandwidth;
+
+    bool compression = stream.getCompression();
+    uint16_t quality = std::min( std::max( stream.getQuality(), _minQuality ),
+                                 _maxQuality );
+    if( overloaded )
+    {
+        _nGood = 0;
+        if( compression && decodeLimited && canUncompress )
+            compression = false;
+        else if( compression )
+            quality = std::max( uint16_t( quality * 3 / 4 ), _minQuality );
+        else
+        {
+            compression = true;
+            quality = _maxQuality;
+            _uncompressedFailed = true;
+        }
+    }
+    else if( frameRate < _targetFPS )
+        _nGood = 0;
+    else if( ++_nGood >= _increaseDelay )
+    {
+        _nGood = 0;
+        const bool hasBandwidth = _maxBandwidth <= 0.0 ||
+                                  bandwidth * 1.2 < _maxBandwidth;
+        if( quality < _maxQuality && hasBandwidth )
+            quality = std::min( uint16_t( quality + _qualityStep ),
+                                _maxQuality );
+        else if( quality == _maxQuality && compression &&
+                 decodeTime > 0.5 * frameTime && canUncompress )
+        {
+            compression = false;
+        }
+    }
+
+    if( compression == stream.getCompression() &&
+        quality == stream.getQuality( ))
+    {
+        return false;
+    }
+    stream.setCompression( compression );
+    stream.setQuality( quality );
+    return true;
+}
+
+}
+}
@@ -0,0 +1,76 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#pragma once
+
+#include <lexis/api.h>
+#include <lexis/render/stream.h>
+#include <lexis/render/streamFeedback.h>
+
+namespace lexis
+{
+namespace render
+{
+
+/**
+ * Adapts the compression and quality of a Stream to the StreamFeedback of its
+ * receiver to achieve a target frame rate.
+ *
+ * If the receiver falls behind the target frame rate because of the transport
+ * or decoding, i.e. latency or decode time exceed the frame time, the quality
+ * is decreased multiplicatively and an uncompressed stream is compressed. If
+ * the target frame rate is met for several updates, the quality is increased
+ * in steps as long as the bandwidth allows. With a known link bandwidth, a
+ * stream limited by decoding rather than the transport is sent uncompressed
+ * instead. If the uncompressed stream overloads the link, it is not tried
+ * again until the link or target changes or the stream recovered for a while.
+ */
+class StreamController
+{
+public:
+    /** @param targetFPS the frame rate to achieve at the receiver */
+    LEXIS_API explicit StreamController( double targetFPS = 30.0 );
+
+    /** Set the frame rate to achieve at the receiver. */
+    LEXIS_API void setTargetFPS( double fps );
+
+    /** @return the frame rate to achieve at the receiver. */
+    double getTargetFPS() const { return _targetFPS; }
+
+    /** Set the range of the compression quality, [20, 95] by default. */
+    LEXIS_API void setQualityRange( uint16_t minQuality, uint16_t maxQuality );
+
+    uint16_t getMinQuality() const { return _minQuality; }
+    uint16_t getMaxQuality() const { return _maxQuality; }
+
+    /**
+     * Set the bandwidth of the link in bytes per second, 0 if unknown. The
+     * stream is never sent uncompressed if the bandwidth is unknown.
+     */
+    LEXIS_API void setMaxBandwidth( double bandwidth );
+
+    /** @return the bandwidth of the link in bytes per second, 0 if unknown. */
+    double getMaxBandwidth() const { return _maxBandwidth; }
+
+    /**
+     * Adapt the stream to the latest feedback of its receiver.
+     *
+     * @param feedback the measurements of the receiver
+     * @param stream the stream parameters to adapt
+     * @return true if the stream has changed and is to be published.
+     */
+    LEXIS_API bool update( const StreamFeedback& feedback, Stream& stream );
+
+private:
+    double _targetFPS;
+    uint16_t _minQuality = 20;
+    uint16_t _maxQuality = 95;
+    double _maxBandwidth = 0.0;
+    size_t _nGood = 0; // consecutive updates meeting the target frame rate
+    bool _uncompressedFailed = false;
+    size_t _nRetry = 0; // updates without overload since uncompressed failed
+};
+
+}
+}
@@ -0,0 +1,46 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#include "Telemetry.h"
+
+namespace lexis
+{
+namespace render
+{
+
+const size_t Telemetry::nStages;
+
+Histogram Telemetry::getFrameTimeHistogram() const
+{
+    const auto& bins = getFrameTimes();
+    Histogram histogram;
+    histogram.setBins( std::vector< uint64_t >( bins.data(),
+                                                bins.data() + bins.size( )));
+    histogram.setMin( 0.f );
+    histogram.setMax( getMaxFrameTime( ));
+    return histogram;
+}
+
+double Telemetry::getAverageFrameTime() const
+{
+    if( getFrames() == 0 )
+        return 0.0;
+    return getFrameTime() / double( getFrames( ));
+}
+
+double Telemetry::getAverageStageTime( const Stage stage ) const
+{
+    if( getFrames() == 0 )
+        return 0.0;
+    return getStageTimes()[ size_t( stage ) ] / double( getFrames( ));
+}
+
+double Telemetry::getCacheHitRate() const
+{
+    const uint64_t requests = getCacheHits() + getCacheMisses();
+    return requests == 0 ? 0.0 : double( getCacheHits( )) / double( requests );
+}
+
+}
+}
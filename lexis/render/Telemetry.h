@@ -0,0 +1,39 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#pragma once
+
+#include <lexis/api.h>
+#include <lexis/render/Histogram.h>
+#include <lexis/render/detail/telemetry.h> // base class
+
+namespace lexis
+{
+namespace render
+{
+
+using Stage = detail::Stage;
+
+/** Performance data of a rendering pipeline over a period of time. */
+class Telemetry : public detail::Telemetry
+{
+public:
+    /** The number of pipeline stages with a time in the event. */
+    static const size_t nStages = size_t( Stage::Transfer ) + 1;
+
+    /** @return the histogram of the frame times in seconds. */
+    LEXIS_API Histogram getFrameTimeHistogram() const;
+
+    /** @return the average frame time in seconds, 0 without frames. */
+    LEXIS_API double getAverageFrameTime() const;
+
+    /** @return the average time per frame of a stage in seconds. */
+    LEXIS_API double getAverageStageTime( Stage stage ) const;
+
+    /** @return the ratio of brick requests served from the cache. */
+    LEXIS_API double getCacheHitRate() const;
+};
+
+}
+}
@@ -0,0 +1,163 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#include "TelemetryCollector.h"
+
+#include <lexis/detail/PeriodicThread.h>
+
+#include <functional>
+
+namespace lexis
+{
+namespace render
+{
+namespace
+{
+double _toSeconds( const uint64_t nanoseconds )
+{
+    return double( nanoseconds ) * 1e-9;
+}
+
+// Calls the functions registered by a thread when it exits
+struct OnThreadExit
+{
+    ~OnThreadExit()
+    {
+        for( const auto& func : funcs )
+            func();
+    }
+
+    std::vector< std::function< void() >> funcs;
+};
+
+thread_local OnThreadExit _onThreadExit;
+}
+
+TelemetryCollector::Recorder::Recorder( const size_t nBins,
+                                        const uint64_t binWidth )
+    : _storage( new std::atomic< uint64_t >[ nCounters + nBins +
+                                             2 * _padding ]())
+    , _values( _storage.get() + _padding )
+    , _nBins( nBins )
+    , _binWidth( binWidth )
+{
+}
+
+TelemetryCollector::TelemetryCollector( const Clock::duration maxFrameTime,
+                                        const size_t nBins )
+    : _nBins( std::max( nBins, size_t( 1 )))
+    , _binWidth( std::max( uint64_t(
+          std::chrono::duration_cast< std::chrono::nanoseconds >(
+              maxFrameTime ).count( ) / _nBins ), uint64_t( 1 )))
+    , _registry( std::make_shared< Registry >( ))
+{
+    _registry->retired.resize( Recorder::nCounters + _nBins, 0 );
+    _registry->collected.resize( Recorder::nCounters + _nBins, 0 );
+    _registry->lastCollect = Clock::now();
+}
+
+TelemetryCollector::~TelemetryCollector()
+{
+    stopPublishing();
+}
+
+TelemetryCollector::Recorder& TelemetryCollector::createRecorder()
+{
+    std::unique_ptr< Recorder > recorder( new Recorder( _nBins, _binWidth ));
+    const Recorder* ptr = recorder.get();
+    const std::weak_ptr< Registry > registry = _registry;
+    _onThreadExit.funcs.push_back( [registry, ptr]
+    {
+        if( const auto shared = registry.lock( ))
+            _retire( *shared, ptr );
+    });
+
+    std::lock_guard< std::mutex > lock( _registry->mutex );
+    _registry->recorders.push_back( std::move( recorder ));
+    return *_registry->recorders.back();
+}
+
+size_t TelemetryCollector::getNumRecorders() const
+{
+    std::lock_guard< std::mutex > lock( _registry->mutex );
+    return _registry->recorders.size();
+}
+
+void TelemetryCollector::_retire( Registry& registry,
+                                  const Recorder* recorder )
+{
+    std::lock_guard< std::mutex > lock( registry.mutex );
+    auto& recorders = registry.recorders;
+    const auto i = std::find_if( recorders.begin(), recorders.end(),
+                                 [recorder]( const std::unique_ptr< Recorder >&
+                                             candidate )
+                                     { return candidate.get() == recorder; });
+    if( i == recorders.end( ))
+        return;
+
+    for( size_t j = 0; j < registry.retired.size(); ++j )
+        registry.retired[j] += recorder->_get( j );
+    recorders.erase( i );
+}
+
+Telemetry TelemetryCollector::collect()
+{
+    Registry& registry = *_registry;
+    std::vector< uint64_t > delta( registry.retired.size( ));
+    const Clock::time_point now = Clock::now();
+    double duration = 0.0;
+    {
+        std::lock_guard< std::mutex > lock( registry.mutex );
+        std::vector< uint64_t > totals = registry.retired;
+        for( const auto& recorder : registry.recorders )
+            for( size_t i = 0; i < totals.size(); ++i )
+                totals[i] += recorder->_get( i );
+
+        for( size_t i = 0; i < totals.size(); ++i )
+            delta[i] = totals[i] - registry.collected[i];
+        registry.collected.swap( totals );
+        duration = std::chrono::duration< double >(
+                       now - registry.lastCollect ).count();
+        registry.lastCollect = now;
+    }
+
+    Telemetry telemetry;
+    telemetry.setDuration( duration );
+    telemetry.setFrames( delta[ Recorder::frames ] );
+    telemetry.setFrameTime( _toSeconds( delta[ Recorder::totalFrameTime ] ));
+
+    double stageTimes[ Telemetry::nStages ];
+    for( size_t i = 0; i < Telemetry::nStages; ++i )
+        stageTimes[i] = _toSeconds( delta[ Recorder::stageTimes + i ] );
+    telemetry.setStageTimes( stageTimes );
+
+    telemetry.setFrameTimes( std::vector< uint64_t >(
+        delta.begin() + Recorder::nCounters, delta.end( )));
+    telemetry.setMaxFrameTime( float( _toSeconds( _binWidth * _nBins )));
+
+    telemetry.setVisibleBricks( delta[ Recorder::visibleBricks ] );
+    telemetry.setCulledBricks( delta[ Recorder::culledBricks ] );
+    telemetry.setBytesLoaded( delta[ Recorder::bytesLoaded ] );
+    telemetry.setCacheHits( delta[ Recorder::cacheHits ] );
+    telemetry.setCacheMisses( delta[ Recorder::cacheMisses ] );
+    return telemetry;
+}
+
+void TelemetryCollector::startPublishing(
+    const PublishFunc& publish, const std::chrono::milliseconds interval )
+{
+    stopPublishing();
+    collect(); // start the first period now
+
+    _publisher.reset( new lexis::detail::PeriodicThread(
+        [this, publish] { publish( collect( )); }, interval ));
+}
+
+void TelemetryCollector::stopPublishing()
+{
+    _publisher.reset();
+}
+
+}
+}
@@ -0,0 +1,213 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#pragma once
+
+#include <lexis/api.h>
+#include <lexis/types.h>
+#include <lexis/render/Telemetry.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace lexis
+{
+namespace detail { class PeriodicThread; }
+
+namespace render
+{
+
+/**
+ * Low-overhead collection of Telemetry from multiple threads.
+ *
+ * Each thread records into its own Recorder, which only updates counters and
+ * frame time histogram bins in memory private to the thread, without locks or
+ * atomic read-modify-write operations. collect() sums all recorders into a
+ * Telemetry event covering the time since the previous collection, either
+ * called by the application or periodically by a publishing thread. The
+ * recorders of a thread are removed when it exits, their data is kept for the
+ * next collection, so short-lived worker threads do not accumulate.
+ *
+ * Counters recorded concurrently to a collection may be accounted to the next
+ * collection.
+ *
+ * Example:
+ * @code
+ * lexis::render::TelemetryCollector collector;
+ * // publisher is not used elsewhere, the publishing thread calls it
+ * collector.startPublishing( [&]( const servus::Serializable& event )
+ *                                { return publisher.publish( event ); },
+ *                            std::chrono::seconds( 1 ));
+ *
+ * // in each render thread
+ * auto& recorder = collector.createRecorder();
+ * recorder.addStageTime( lexis::render::Stage::Render, renderTime );
+ * recorder.addFrame( frameTime );
+ * @endcode
+ */
+class TelemetryCollector
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using PublishFunc = lexis::PublishFunc;
+
+    /**
+     * Records the data of one thread. Only to be used by a single thread at a
+     * time.
+     */
+    class Recorder
+    {
+    public:
+        /** Add a rendered frame taking frameTime. */
+        void addFrame( const Clock::duration frameTime )
+        {
+            const uint64_t time = _toNanoseconds( frameTime );
+            _add( frames, 1 );
+            _add( totalFrameTime, time );
+            _add( nCounters + size_t( std::min( time / _binWidth,
+                                                uint64_t( _nBins - 1 ))), 1 );
+        }
+
+        /** Add time spent in a pipeline stage. */
+        void addStageTime( const Stage stage, const Clock::duration time )
+        {
+            _add( stageTimes + size_t( stage ), _toNanoseconds( time ));
+        }
+
+        /** Add the number of rendered and culled bricks. */
+        void addBricks( const uint64_t visible, const uint64_t culled )
+        {
+            _add( visibleBricks, visible );
+            _add( culledBricks, culled );
+        }
+
+        /** Add bytes loaded from the data source. */
+        void addBytesLoaded( const uint64_t bytes )
+        {
+            _add( bytesLoaded, bytes );
+        }
+
+        /** Add brick requests served from the cache and from the source. */
+        void addCacheRequests( const uint64_t hits, const uint64_t misses )
+        {
+            _add( cacheHits, hits );
+            _add( cacheMisses, misses );
+        }
+
+    private:
+        friend class TelemetryCollector;
+
+        enum Counter
+        {
+            frames,
+            totalFrameTime,
+            stageTimes,
+            visibleBricks = stageTimes + Telemetry::nStages,
+            culledBricks,
+            bytesLoaded,
+            cacheHits,
+            cacheMisses,
+            nCounters
+        };
+
+        Recorder( size_t nBins, uint64_t binWidth );
+
+        // the counters followed by the histogram bins, padded by a cache line
+        // on each side against false sharing with other allocations
+        static const size_t _padding = 64 / sizeof( uint64_t );
+        std::unique_ptr< std::atomic< uint64_t >[] > _storage;
+        std::atomic< uint64_t >* const _values;
+        const size_t _nBins;
+        const uint64_t _binWidth; // in nanoseconds
+
+        // only the owning thread writes, so a relaxed load and store suffices
+        void _add( const size_t index, const uint64_t value )
+        {
+            std::atomic< uint64_t >& counter = _values[ index ];
+            counter.store( counter.load( std::memory_order_relaxed ) + value,
+                           std::memory_order_relaxed );
+        }
+
+        uint64_t _get( const size_t index ) const
+        {
+            return _values[ index ].load( std::memory_order_relaxed );
+        }
+
+        static uint64_t _toNanoseconds( const Clock::duration time )
+        {
+            const auto count =
+                std::chrono::duration_cast< std::chrono::nanoseconds >(
+                    time ).count();
+            return count > 0 ? uint64_t( count ) : 0;
+        }
+    };
+
+    /**
+     * @param maxFrameTime the upper bound of the frame time histogram
+     * @param nBins the number of bins of the frame time histogram
+     */
+    LEXIS_API explicit TelemetryCollector(
+        Clock::duration maxFrameTime = std::chrono::milliseconds( 100 ),
+        size_t nBins = 50 );
+
+    /** Stop publishing. */
+    LEXIS_API ~TelemetryCollector();
+
+    /**
+     * @return a new recorder for the calling thread, valid until the thread
+     *         exits or the collector is destroyed. Thread safe.
+     */
+    LEXIS_API Recorder& createRecorder();
+
+    /** @return the number of recorders of running threads. Thread safe. */
+    LEXIS_API size_t getNumRecorders() const;
+
+    /**
+     * @return the data of all recorders since the previous collection. Thread
+     *         safe.
+     */
+    LEXIS_API Telemetry collect();
+
+    /**
+     * Publish the collected data periodically from a thread until
+     * stopPublishing() or destruction. The first period starts now, data
+     * recorded before is discarded. The publish function is called from the
+     * publishing thread and has to be synchronized with other uses of its
+     * publisher.
+     */
+    LEXIS_API void startPublishing( const PublishFunc& publish,
+                                    std::chrono::milliseconds interval );
+
+    /** Stop the publishing thread, if any. */
+    LEXIS_API void stopPublishing();
+
+private:
+    TelemetryCollector( const TelemetryCollector& ) = delete;
+    TelemetryCollector& operator=( const TelemetryCollector& ) = delete;
+
+    // shared with the threads which retire their recorders on exit
+    struct Registry
+    {
+        std::mutex mutex; // protects all members below
+        std::vector< std::unique_ptr< Recorder >> recorders;
+        std::vector< uint64_t > retired;   // data of exited threads
+        std::vector< uint64_t > collected; // data at the last collect()
+        Clock::time_point lastCollect;
+    };
+
+    const size_t _nBins;
+    const uint64_t _binWidth;
+    const std::shared_ptr< Registry > _registry;
+
+    std::unique_ptr< lexis::detail::PeriodicThread > _publisher;
+
+    static void _retire( Registry& registry, const Recorder* recorder );
+};
+
+}
+}
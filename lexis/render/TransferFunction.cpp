@@ -0,0 +1,151 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#include "TransferFunction.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace lexis
+{
+namespace render
+{
+namespace
+{
+const size_t _nChannels = size_t( detail::Channel::Contribution ) + 1;
+
+struct Point
+{
+    float position;
+    float value;
+    float width;
+
+    bool operator<( const Point& rhs ) const { return position < rhs.position; }
+};
+
+struct ChannelPoints
+{
+    std::vector< Point > linear; // sorted by position
+    std::vector< Point > gaussian;
+
+    bool empty() const { return linear.empty() && gaussian.empty(); }
+
+    float evaluate( const float x ) const
+    {
+        float value = 0.f;
+        if( !linear.empty( ))
+        {
+            const Point key = { x, 0.f, 0.f };
+            const auto next = std::upper_bound( linear.begin(), linear.end(),
+                                                key );
+            if( next == linear.begin( ))
+                value = next->value;
+            else if( next == linear.end( ))
+                value = linear.back().value;
+            else
+            {
+                const Point& prev = *( next - 1 );
+                const float t = ( x - prev.position ) /
+                                ( next->position - prev.position );
+                value = prev.value + t * ( next->value - prev.value );
+            }
+        }
+
+        for( const auto& point : gaussian )
+        {
+            const float d = ( x - point.position ) / point.width;
+            value += point.value * std::exp( -0.5f * d * d );
+        }
+        return std::min( std::max( value, 0.f ), 1.f );
+    }
+};
+
+template< class P > ChannelPoints _collect( const P& points, const size_t index )
+{
+    ChannelPoints channel;
+    for( const auto& controlPoint : points )
+    {
+        if( size_t( controlPoint.getChannel( )) != index )
+            continue;
+
+        const Point point = { controlPoint.getPosition(),
+                              controlPoint.getValue(),
+                              controlPoint.getWidth() };
+        if( controlPoint.getType() == detail::ControlPointType::Linear )
+            channel.linear.push_back( point );
+        else if( point.width > 0.f )
+            channel.gaussian.push_back( point );
+    }
+    std::stable_sort( channel.linear.begin(), channel.linear.end( ));
+    return channel;
+}
+
+std::vector< float > _sample( const ChannelPoints& channel, const size_t size )
+{
+    if( channel.empty( ))
+        return {};
+
+    std::vector< float > values( size );
+    const float step = size > 1 ? 1.f / float( size - 1 ) : 0.f;
+    for( size_t i = 0; i < size; ++i )
+        values[i] = channel.evaluate( float( i ) * step );
+    return values;
+}
+
+std::vector< detail::Color > _merge( const std::vector< float >& red,
+                                     const std::vector< float >& green,
+                                     const std::vector< float >& blue,
+                                     const size_t size )
+{
+    if( red.empty() && green.empty() && blue.empty( ))
+        return {};
+
+    std::vector< detail::Color > colors( size );
+    for( size_t i = 0; i < size; ++i )
+    {
+        colors[i].setRed( red.empty() ? 0.f : red[i] );
+        colors[i].setGreen( green.empty() ? 0.f : green[i] );
+        colors[i].setBlue( blue.empty() ? 0.f : blue[i] );
+    }
+    return colors;
+}
+}
+
+float TransferFunction::evaluate( const detail::Channel channel,
+                                  const float position ) const
+{
+    return _collect( getPoints(), size_t( channel )).evaluate( position );
+}
+
+const MaterialLUT& TransferFunction::getMaterialLUT( const size_t size ) const
+{
+    if( _lutSize == size && _sampled == *this )
+        return _lut;
+
+    std::vector< float > channels[ _nChannels ];
+    for( size_t i = 0; i < _nChannels; ++i )
+        channels[i] = _sample( _collect( getPoints(), i ), size );
+
+    using detail::Channel;
+    auto get = [&]( const Channel channel ) -> std::vector< float >&
+        { return channels[ size_t( channel ) ]; };
+
+    double range[] = { getRange()[0], getRange()[1] };
+    _lut.setRange( range );
+    _lut.setDiffuse( _merge( get( Channel::DiffuseRed ),
+                             get( Channel::DiffuseGreen ),
+                             get( Channel::DiffuseBlue ), size ));
+    _lut.setEmission( _merge( get( Channel::EmissionRed ),
+                              get( Channel::EmissionGreen ),
+                              get( Channel::EmissionBlue ), size ));
+    _lut.setAlpha( get( Channel::Alpha ));
+    _lut.setContribution( get( Channel::Contribution ));
+
+    _sampled = *this;
+    _lutSize = size;
+    return _lut;
+}
+
+}
+}
@@ -0,0 +1,47 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#pragma once
+
+#include <lexis/api.h>
+#include <lexis/render/MaterialLUT.h>
+#include <lexis/render/detail/transferFunction.h> // base class
+
+namespace lexis
+{
+namespace render
+{
+
+/**
+ * Transfer function defined by control points, evaluated to a MaterialLUT.
+ *
+ * The generated lookup table is cached until the control points change, so it
+ * can be requested every frame at no cost. getMaterialLUT() is not thread safe.
+ */
+class TransferFunction : public detail::TransferFunction
+{
+public:
+    /**
+     * @param channel the channel to evaluate
+     * @param position the normalized position in [0..1] within the range
+     * @return the value of the channel at the given position in [0..1], 0 if
+     *         the channel has no control points.
+     */
+    LEXIS_API float evaluate( detail::Channel channel, float position ) const;
+
+    /**
+     * @param size the number of entries of the lookup table
+     * @return the lookup table sampling all channels at size equidistant
+     *         positions over the range.
+     */
+    LEXIS_API const MaterialLUT& getMaterialLUT( size_t size ) const;
+
+private:
+    mutable detail::TransferFunction _sampled; // content the LUT is sampled of
+    mutable MaterialLUT _lut;
+    mutable size_t _lutSize = 0;
+};
+
+}
+}
@@ -0,0 +1,18 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#pragma once
+
+#include <functional>
+
+namespace servus { class Serializable; }
+
+namespace lexis
+{
+/**
+ * Publishes an event, e.g. by binding zeroeq::Publisher::publish().
+ * @return true if the event was published.
+ */
+using PublishFunc = std::function< bool( const servus::Serializable& ) >;
+}
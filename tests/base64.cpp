@@ -0,0 +1,86 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#define BOOST_TEST_MODULE base64
+
+#include <lexis/base64.h>
+#include <lexis/render/imageJPEG.h>
+#include <boost/test/unit_test.hpp>
+
+#include <random>
+
+namespace
+{
+std::vector< uint8_t > _createData( const size_t size )
+{
+    std::mt19937 engine( static_cast< uint32_t >( size ));
+    std::uniform_int_distribution< int > distribution( 0, 255 );
+    std::vector< uint8_t > data( size );
+    for( auto& byte : data )
+        byte = uint8_t( distribution( engine ));
+    return data;
+}
+}
+
+BOOST_AUTO_TEST_CASE( encode )
+{
+    BOOST_CHECK_EQUAL( lexis::encodeBase64( nullptr, 0 ), "" );
+    BOOST_CHECK_EQUAL( lexis::encodeBase64( "f", 1 ), "Zg==" );
+    BOOST_CHECK_EQUAL( lexis::encodeBase64( "fo", 2 ), "Zm8=" );
+    BOOST_CHECK_EQUAL( lexis::encodeBase64( "foo", 3 ), "Zm9v" );
+    BOOST_CHECK_EQUAL( lexis::encodeBase64( "foobar", 6 ), "Zm9vYmFy" );
+
+    std::vector< uint8_t > data;
+    for( uint8_t i = 0; i < 16; ++i )
+        data.push_back( i );
+    BOOST_CHECK_EQUAL( lexis::encodeBase64( data.data(), data.size( )),
+                       "AAECAwQFBgcICQoLDA0ODw==" );
+}
+
+BOOST_AUTO_TEST_CASE( decode )
+{
+    std::vector< uint8_t > data;
+    BOOST_CHECK( lexis::decodeBase64( "", data ));
+    BOOST_CHECK( data.empty( ));
+
+    BOOST_CHECK( lexis::decodeBase64( "Zm9vYg==", data ));
+    BOOST_CHECK_EQUAL( std::string( data.begin(), data.end( )), "foob" );
+
+    BOOST_CHECK( !lexis::decodeBase64( "Zm9vY", data ));
+    BOOST_CHECK( !lexis::decodeBase64( "Zm9=Yg==", data ));
+    BOOST_CHECK( !lexis::decodeBase64( "Zm9v\nYmFy", data ));
+}
+
+BOOST_AUTO_TEST_CASE( roundTrip )
+{
+    // covers the vectorized body and all scalar tail lengths
+    for( size_t size = 0; size < 200; ++size )
+    {
+        const auto data = _createData( size );
+        const std::string encoded = lexis::encodeBase64( data.data(), size );
+
+        std::vector< uint8_t > decoded;
+        BOOST_CHECK( lexis::decodeBase64( encoded, decoded ));
+        BOOST_CHECK( decoded == data );
+
+        if( size == 0 )
+            continue;
+
+        // invalid characters are detected anywhere in the input
+        std::string invalid = encoded;
+        invalid[ size % ( encoded.size() - 2 ) ] = '*';
+        BOOST_CHECK( !lexis::decodeBase64( invalid, decoded ));
+    }
+}
+
+BOOST_AUTO_TEST_CASE( matchesImageJPEGJSON )
+{
+    lexis::render::ImageJPEG image;
+    image.setData( _createData( 4711 ));
+
+    const std::string json = image.toJSON();
+    const std::string encoded = lexis::encodeBase64( image.getData().data(),
+                                                     image.getData().size( ));
+    BOOST_CHECK( json.find( "\"" + encoded + "\"" ) != std::string::npos );
+}
@@ -0,0 +1,118 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#define BOOST_TEST_MODULE CoalescingPublisher
+
+#include <lexis/CoalescingPublisher.h>
+#include <lexis/render/ClipPlanes.h>
+#include <lexis/render/frame.h>
+#include <lexis/render/lookOut.h>
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <thread>
+
+using lexis::render::Frame;
+using std::chrono::milliseconds;
+
+namespace
+{
+struct Published
+{
+    std::atomic< size_t > frames{ 0 };
+    std::atomic< size_t > lookOuts{ 0 };
+    std::atomic< uint32_t > lastFrame{ 0 };
+
+    bool operator()( const servus::Serializable& event )
+    {
+        if( event.getTypeIdentifier() == Frame().getTypeIdentifier( ))
+        {
+            ++frames;
+            lastFrame = static_cast< const Frame& >( event ).getCurrent();
+        }
+        else
+            ++lookOuts;
+        return true;
+    }
+};
+}
+
+BOOST_AUTO_TEST_CASE( latestValueWins )
+{
+    Published published;
+    lexis::CoalescingPublisher publisher( std::ref( published ),
+                                          milliseconds( 100000 ));
+    for( uint32_t i = 0; i < 1000; ++i )
+        publisher.publish( Frame( 0, i, 1000, 1 ));
+    publisher.publish( lexis::render::LookOut( ));
+
+    publisher.flush();
+    BOOST_CHECK_EQUAL( published.frames, 1 );
+    BOOST_CHECK_EQUAL( published.lookOuts, 1 );
+    BOOST_CHECK_EQUAL( published.lastFrame, 999 );
+
+    // nothing pending, nothing published
+    publisher.flush();
+    BOOST_CHECK_EQUAL( published.frames, 1 );
+
+    publisher.publish( Frame( 0, 42, 1000, 1 ));
+    publisher.flush();
+    BOOST_CHECK_EQUAL( published.frames, 2 );
+    BOOST_CHECK_EQUAL( published.lastFrame, 42 );
+}
+
+BOOST_AUTO_TEST_CASE( flushOnDestruction )
+{
+    Published published;
+    {
+        lexis::CoalescingPublisher publisher( std::ref( published ),
+                                              milliseconds( 100000 ));
+        publisher.publish( Frame( 0, 17, 1000, 1 ));
+    }
+    BOOST_CHECK_EQUAL( published.frames, 1 );
+    BOOST_CHECK_EQUAL( published.lastFrame, 17 );
+}
+
+BOOST_AUTO_TEST_CASE( flushThread )
+{
+    Published published;
+    lexis::CoalescingPublisher publisher( std::ref( published ),
+                                          milliseconds( 1 ));
+    publisher.publish( Frame( 0, 4, 1000, 1 ));
+    for( size_t i = 0; i < 1000 && published.frames == 0; ++i )
+        std::this_thread::sleep_for( milliseconds( 10 ));
+    BOOST_CHECK_EQUAL( published.frames, 1 );
+}
+
+BOOST_AUTO_TEST_CASE( sharedTypeIdentifier )
+{
+    // a class and its generated base class share the type identifier
+    size_t nPublished = 0;
+    size_t nPlanes = 0;
+    lexis::CoalescingPublisher publisher(
+        [&]( const servus::Serializable& event )
+        {
+            ++nPublished;
+            nPlanes = static_cast< const lexis::render::detail::ClipPlanes& >(
+                          event ).getPlanes().size();
+            return true;
+        },
+        milliseconds( 100000 ));
+
+    lexis::render::detail::ClipPlanes base;
+    base.setPlanes( { { { 1.f, 0.f, 0.f }, 0.f } } );
+    lexis::render::ClipPlanes derived;
+
+    publisher.publish( base );
+    publisher.publish( derived );
+    publisher.flush();
+    BOOST_CHECK_EQUAL( nPublished, 1 );
+    BOOST_CHECK_EQUAL( nPlanes, 6 );
+
+    publisher.publish( derived );
+    publisher.publish( base );
+    publisher.flush();
+    BOOST_CHECK_EQUAL( nPublished, 2 );
+    BOOST_CHECK_EQUAL( nPlanes, 1 );
+}
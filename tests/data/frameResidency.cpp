@@ -0,0 +1,124 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#define BOOST_TEST_MODULE data_frameResidency
+
+#include <boost/test/unit_test.hpp>
+
+#include <lexis/data/FrameResidency.h>
+
+using lexis::data::FrameResidency;
+using State = FrameResidency::State;
+
+namespace
+{
+template< class V > std::vector< uint32_t > _runs( const V& runs )
+{
+    return std::vector< uint32_t >( runs.data(), runs.data() + runs.size( ));
+}
+}
+
+BOOST_AUTO_TEST_CASE( defaults )
+{
+    const FrameResidency residency;
+    BOOST_CHECK( residency.getState( 0 ) == State::absent );
+    BOOST_CHECK_EQUAL( residency.getNumResident(), 0 );
+
+    uint32_t nearest = 0;
+    BOOST_CHECK( !residency.findNearestResident( 42, nearest ));
+}
+
+BOOST_AUTO_TEST_CASE( update )
+{
+    FrameResidency residency;
+    residency.setState( 10, 20, State::resident );
+    residency.setState( 20, State::resident );
+    residency.setState( 30, 40, State::loading );
+    residency.setState( 35, 50, State::resident );
+
+    const std::vector< uint32_t > resident = { 10, 21, 35, 50 };
+    const std::vector< uint32_t > loading = { 30, 35 };
+    BOOST_CHECK( _runs( residency.getResident( )) == resident );
+    BOOST_CHECK( _runs( residency.getLoading( )) == loading );
+    BOOST_CHECK_EQUAL( residency.getNumResident(), 26 );
+
+    BOOST_CHECK( residency.getState( 9 ) == State::absent );
+    BOOST_CHECK( residency.getState( 10 ) == State::resident );
+    BOOST_CHECK( residency.getState( 20 ) == State::resident );
+    BOOST_CHECK( residency.getState( 21 ) == State::absent );
+    BOOST_CHECK( residency.getState( 34 ) == State::loading );
+    BOOST_CHECK( residency.isResident( 49 ));
+    BOOST_CHECK( !residency.isResident( 50 ));
+
+    residency.setState( 15, 40, State::absent );
+    const std::vector< uint32_t > evicted = { 10, 15, 40, 50 };
+    BOOST_CHECK( _runs( residency.getResident( )) == evicted );
+    BOOST_CHECK( residency.getLoading().empty( ));
+
+    residency.setState( 15, 40, State::resident );
+    const std::vector< uint32_t > merged = { 10, 50 };
+    BOOST_CHECK( _runs( residency.getResident( )) == merged );
+}
+
+BOOST_AUTO_TEST_CASE( nearest )
+{
+    FrameResidency residency;
+    residency.setState( 10, 20, State::resident );
+    residency.setState( 30, 40, State::resident );
+
+    uint32_t frame = 0;
+    BOOST_CHECK( residency.findNearestResident( 0, frame ));
+    BOOST_CHECK_EQUAL( frame, 10 );
+    BOOST_CHECK( residency.findNearestResident( 15, frame ));
+    BOOST_CHECK_EQUAL( frame, 15 );
+    BOOST_CHECK( residency.findNearestResident( 22, frame ));
+    BOOST_CHECK_EQUAL( frame, 19 );
+    BOOST_CHECK( residency.findNearestResident( 28, frame ));
+    BOOST_CHECK_EQUAL( frame, 30 );
+    BOOST_CHECK( residency.findNearestResident( 100, frame ));
+    BOOST_CHECK_EQUAL( frame, 39 );
+}
+
+BOOST_AUTO_TEST_CASE( merge )
+{
+    FrameResidency first;
+    first.setState( 0, 10, State::resident );
+    first.setState( 10, 20, State::loading );
+
+    FrameResidency second;
+    second.setState( 15, 30, State::resident );
+    second.setState( 40, 50, State::loading );
+
+    first |= second;
+    const std::vector< uint32_t > resident = { 0, 10, 15, 30 };
+    const std::vector< uint32_t > loading = { 10, 15, 40, 50 };
+    BOOST_CHECK( _runs( first.getResident( )) == resident );
+    BOOST_CHECK( _runs( first.getLoading( )) == loading );
+}
+
+BOOST_AUTO_TEST_CASE( oddRuns )
+{
+    // odd numbers of run boundaries, e.g. received from a broken peer
+    FrameResidency malformed;
+    malformed.setResident( std::vector< uint32_t >{ 10, 20, 30 } );
+    malformed.setLoading( std::vector< uint32_t >{ 5 } );
+
+    BOOST_CHECK( malformed.getState( 15 ) == State::absent );
+    BOOST_CHECK( malformed.getState( 35 ) == State::absent );
+    BOOST_CHECK_EQUAL( malformed.getNumResident(), 0 );
+    uint32_t nearest = 0;
+    BOOST_CHECK( !malformed.findNearestResident( 15, nearest ));
+
+    FrameResidency residency;
+    residency.setState( 0, 10, State::resident );
+    residency |= malformed;
+    const std::vector< uint32_t > resident = { 0, 10 };
+    BOOST_CHECK( _runs( residency.getResident( )) == resident );
+    BOOST_CHECK( residency.getLoading().empty( ));
+
+    malformed.setState( 40, 50, State::resident );
+    const std::vector< uint32_t > repaired = { 40, 50 };
+    BOOST_CHECK( _runs( malformed.getResident( )) == repaired );
+    BOOST_CHECK( malformed.getLoading().empty( ));
+}
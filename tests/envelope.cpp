@@ -0,0 +1,106 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#define BOOST_TEST_MODULE Envelope
+
+#include <lexis/Envelope.h>
+#include <lexis/render/frame.h>
+#include <lexis/render/lookOut.h>
+#include <boost/test/unit_test.hpp>
+
+using lexis::render::Frame;
+using lexis::render::LookOut;
+
+namespace
+{
+LookOut _lookOut( const double value )
+{
+    double matrix[16] = { 0 };
+    for( size_t i = 0; i < 16; ++i )
+        matrix[i] = value + i;
+    LookOut lookOut;
+    lookOut.setMatrix( matrix );
+    return lookOut;
+}
+}
+
+BOOST_AUTO_TEST_CASE( empty )
+{
+    const lexis::Envelope envelope;
+    BOOST_CHECK_EQUAL( envelope.getNumEvents(), 0 );
+
+    size_t calls = 0;
+    BOOST_CHECK( envelope.dispatch(
+        [&]( const servus::uint128_t&, const void*, size_t ) { ++calls; }));
+    BOOST_CHECK_EQUAL( calls, 0 );
+}
+
+BOOST_AUTO_TEST_CASE( dispatchInOrder )
+{
+    const Frame first( 0, 1, 10, 1 );
+    const LookOut lookOut = _lookOut( 3 );
+    const Frame second( 0, 2, 10, 1 );
+
+    lexis::Envelope envelope;
+    envelope.add( first );
+    envelope.add({ &lookOut, &second });
+    BOOST_CHECK_EQUAL( envelope.getNumEvents(), 3 );
+
+    std::vector< servus::uint128_t > types;
+    std::vector< const void* > data;
+    BOOST_CHECK( envelope.dispatch(
+        [&]( const servus::uint128_t& type, const void* ptr, size_t size )
+        {
+            types.push_back( type );
+            data.push_back( ptr );
+            BOOST_CHECK_GT( size, 0 );
+        }));
+
+    BOOST_REQUIRE_EQUAL( types.size(), 3 );
+    BOOST_CHECK( types[0] == first.getTypeIdentifier( ));
+    BOOST_CHECK( types[1] == lookOut.getTypeIdentifier( ));
+    BOOST_CHECK( types[2] == second.getTypeIdentifier( ));
+
+    // dispatched in place
+    BOOST_CHECK_EQUAL( data[0], envelope.getData().data( ));
+}
+
+BOOST_AUTO_TEST_CASE( dispatchToReceivers )
+{
+    lexis::Envelope envelope;
+    const LookOut lookOut = _lookOut( 42 );
+    envelope.add({ &lookOut });
+    envelope.add( Frame( 0, 1, 10, 1 ));
+    envelope.add( Frame( 0, 5, 10, 1 ));
+
+    Frame frame;
+    LookOut receivedLookOut;
+    BOOST_CHECK( envelope.dispatch({ &frame, &receivedLookOut }));
+    BOOST_CHECK( frame == Frame( 0, 5, 10, 1 )); // last one wins
+    BOOST_CHECK_EQUAL( receivedLookOut.getMatrix()[15], 57 );
+
+    // events without receiver are skipped
+    Frame onlyFrame;
+    BOOST_CHECK( envelope.dispatch({ &onlyFrame }));
+    BOOST_CHECK_EQUAL( onlyFrame.getCurrent(), 5 );
+
+    envelope.clear();
+    BOOST_CHECK_EQUAL( envelope.getNumEvents(), 0 );
+    BOOST_CHECK( envelope.getData().empty( ));
+}
+
+BOOST_AUTO_TEST_CASE( malformed )
+{
+    lexis::Envelope envelope;
+    envelope.add( Frame( 0, 1, 10, 1 ));
+    envelope.add( Frame( 0, 2, 10, 1 ));
+    envelope.getOffsets()[1] = envelope.getData().size() + 1;
+
+    Frame frame;
+    BOOST_CHECK( !envelope.dispatch({ &frame }));
+    BOOST_CHECK_EQUAL( frame.getCurrent(), 0 );
+
+    envelope.getTypes().resize( 1 );
+    BOOST_CHECK( !envelope.dispatch({ &frame }));
+}
@@ -0,0 +1,63 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#define BOOST_TEST_MODULE EventPool
+
+#include <lexis/EventPool.h>
+#include <lexis/render/frame.h>
+#include <boost/test/unit_test.hpp>
+
+using lexis::render::Frame;
+
+BOOST_AUTO_TEST_CASE( recycle )
+{
+    lexis::EventPool< Frame > pool;
+    BOOST_CHECK_EQUAL( pool.getNumFree(), 0 );
+
+    const Frame* address = nullptr;
+    {
+        auto frame = pool.acquire();
+        BOOST_REQUIRE( frame );
+        address = frame.get();
+    }
+    BOOST_CHECK_EQUAL( pool.getNumFree(), 1 );
+
+    auto frame = pool.acquire();
+    BOOST_CHECK_EQUAL( frame.get(), address );
+    BOOST_CHECK_EQUAL( pool.getNumFree(), 0 );
+}
+
+BOOST_AUTO_TEST_CASE( decode )
+{
+    const Frame sent( 0, 42, 100, 1 );
+    const auto binary = sent.toBinary();
+
+    lexis::EventPool< Frame > pool;
+    const Frame* address = nullptr;
+    {
+        auto frame = pool.decode( binary.ptr.get(), binary.size );
+        BOOST_REQUIRE( frame );
+        BOOST_CHECK( *frame == sent );
+        address = frame.get();
+    }
+
+    const Frame next( 0, 43, 100, 1 );
+    const auto nextBinary = next.toBinary();
+    auto frame = pool.decode( nextBinary.ptr.get(), nextBinary.size );
+    BOOST_REQUIRE( frame );
+    BOOST_CHECK_EQUAL( frame.get(), address );
+    BOOST_CHECK( *frame == next );
+}
+
+BOOST_AUTO_TEST_CASE( maxFree )
+{
+    lexis::EventPool< Frame > pool( 2 );
+    {
+        auto a = pool.acquire();
+        auto b = pool.acquire();
+        auto c = pool.acquire();
+        BOOST_CHECK( a.get() != b.get() && b.get() != c.get( ));
+    }
+    BOOST_CHECK_EQUAL( pool.getNumFree(), 2 );
+}
@@ -0,0 +1,72 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#define BOOST_TEST_MODULE perf_base64
+
+#include <lexis/base64.h>
+#include <lexis/render/imageJPEG.h>
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+namespace
+{
+const size_t _megabyte = 1024 * 1024;
+const size_t _loops = 5;
+
+template< class F > float _measure( const size_t size, const F& func )
+{
+    const auto start = std::chrono::high_resolution_clock::now();
+    for( size_t i = 0; i < _loops; ++i )
+        func();
+    const std::chrono::duration< float > elapsed =
+        std::chrono::high_resolution_clock::now() - start;
+    return float( size * _loops ) / float( _megabyte ) / elapsed.count();
+}
+}
+
+BOOST_AUTO_TEST_CASE( throughput )
+{
+    std::cout << "   size, toJSON MB/s, encode MB/s, fromJSON MB/s, "
+              << "decode MB/s" << std::endl;
+
+    for( const size_t megabytes : { 1, 5, 10, 25, 50 })
+    {
+        const size_t size = megabytes * _megabyte;
+        std::vector< uint8_t > data( size );
+        for( size_t i = 0; i < size; ++i )
+            data[i] = uint8_t( i * 7 );
+
+        lexis::render::ImageJPEG image;
+        image.setData( data );
+
+        std::string json;
+        const float toJSON = _measure( size, [&] { json = image.toJSON(); });
+
+        std::string encoded;
+        const float encode = _measure( size, [&] {
+            encoded = lexis::encodeBase64( data.data(), data.size( ));
+        });
+
+        lexis::render::ImageJPEG decodedImage;
+        const float fromJSON = _measure( size, [&] {
+            BOOST_CHECK( decodedImage.fromJSON( json ));
+        });
+
+        std::vector< uint8_t > decoded;
+        const float decode = _measure( size, [&] {
+            BOOST_CHECK( lexis::decodeBase64( encoded, decoded ));
+        });
+
+        BOOST_CHECK( decoded == data );
+        BOOST_CHECK( decodedImage == image );
+        std::cout << std::setw( 4 ) << megabytes << " MB, "
+                  << std::setw( 11 ) << toJSON << ", "
+                  << std::setw( 11 ) << encode << ", "
+                  << std::setw( 13 ) << fromJSON << ", "
+                  << std::setw( 11 ) << decode << std::endl;
+    }
+}
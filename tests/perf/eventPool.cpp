@@ -0,0 +1,130 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#define BOOST_TEST_MODULE perf_eventPool
+
+#include <lexis/EventPool.h>
+#include <lexis/render/imageJPEG.h>
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+
+using lexis::render::ImageJPEG;
+
+namespace
+{
+std::atomic< size_t > _allocations{ 0 };
+
+const size_t _nEvents = 1000;
+const size_t _imageSize = 1024 * 1024;
+}
+
+#ifdef __GLIBC__
+// Count all heap allocations. ZeroBuf allocates its buffers with malloc and
+// realloc, operator new uses malloc as well.
+#  define COUNT_MALLOC
+extern "C"
+{
+void* __libc_malloc( size_t size );
+void* __libc_calloc( size_t count, size_t size );
+void* __libc_realloc( void* ptr, size_t size );
+
+void* malloc( const size_t size ) __THROW
+{
+    ++_allocations;
+    return __libc_malloc( size );
+}
+
+void* calloc( const size_t count, const size_t size ) __THROW
+{
+    ++_allocations;
+    return __libc_calloc( count, size );
+}
+
+void* realloc( void* ptr, const size_t size ) __THROW
+{
+    ++_allocations;
+    return __libc_realloc( ptr, size );
+}
+}
+#else
+// Only operator new can be counted portably, which misses the ZeroBuf buffers;
+// not inlined to not trigger the new/delete mismatch warnings of the compiler
+#  if defined( __GNUC__ ) || defined( __clang__ )
+#    define NOINLINE __attribute__(( noinline ))
+#  else
+#    define NOINLINE
+#  endif
+NOINLINE void* operator new( const size_t size )
+{
+    ++_allocations;
+    if( void* ptr = std::malloc( size ? size : 1 ))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+NOINLINE void operator delete( void* ptr ) noexcept
+{
+    std::free( ptr );
+}
+
+NOINLINE void operator delete( void* ptr, size_t ) noexcept
+{
+    std::free( ptr );
+}
+#endif
+
+namespace
+{
+// Receive _nEvents images, each used briefly and released like on a receive
+// thread handing events to a consumer. Returns allocations per event.
+template< class F > float _receive( const F& decode, float& mbPerSecond )
+{
+    const size_t allocations = _allocations;
+    const auto start = std::chrono::high_resolution_clock::now();
+    for( size_t i = 0; i < _nEvents; ++i )
+        decode();
+    const std::chrono::duration< float > elapsed =
+        std::chrono::high_resolution_clock::now() - start;
+    mbPerSecond = float( _nEvents * _imageSize ) / 1024.f / 1024.f /
+                  elapsed.count();
+    return float( _allocations - allocations ) / float( _nEvents );
+}
+}
+
+BOOST_AUTO_TEST_CASE( decodeImages )
+{
+    ImageJPEG image;
+    image.setData( std::vector< uint8_t >( _imageSize, 42 ));
+    const auto binary = image.toBinary();
+
+    float newSpeed = 0.f;
+    const float newAllocations = _receive( [&] {
+        std::unique_ptr< ImageJPEG > event( new ImageJPEG );
+        BOOST_CHECK( event->fromBinary( binary.ptr.get(), binary.size ));
+    }, newSpeed );
+
+    lexis::EventPool< ImageJPEG > pool;
+    pool.decode( binary.ptr.get(), binary.size ); // warm up
+    float pooledSpeed = 0.f;
+    const float pooledAllocations = _receive( [&] {
+        BOOST_CHECK( pool.decode( binary.ptr.get(), binary.size ));
+    }, pooledSpeed );
+
+#ifdef COUNT_MALLOC
+    BOOST_CHECK_EQUAL( pooledAllocations, 0.f );
+#else
+    BOOST_TEST_MESSAGE( "malloc not counted on this platform, pooled "
+                        "allocations unchecked" );
+#endif
+    std::cout << "Allocations/event new: " << std::setw( 4 ) << newAllocations
+              << " (" << std::setw( 8 ) << newSpeed << " MB/s), pooled: "
+              << std::setw( 4 ) << pooledAllocations << " ("
+              << std::setw( 8 ) << pooledSpeed << " MB/s)" << std::endl;
+}
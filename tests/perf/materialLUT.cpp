@@ -0,0 +1,102 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#define BOOST_TEST_MODULE perf_materialLUT
+
+#include <lexis/render/MaterialLUT.h>
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+using lexis::render::MaterialLUT;
+
+namespace
+{
+const size_t _count = 16 * 1024 * 1024;
+const size_t _lutSize = 4096;
+
+using Colors = std::vector< lexis::render::detail::Color >;
+
+// The per-application loop classify() replaces: double precision math on the
+// LUT entries for each value.
+void _classifyScalar( const Colors& diffuse, const std::vector< float >& alpha,
+                      const double* range, const float* values,
+                      const size_t count, float* rgba )
+{
+    for( size_t i = 0; i < count; ++i )
+    {
+        double x = ( values[i] - range[0] ) / ( range[1] - range[0] );
+        x = std::min( std::max( x, 0.0 ), 1.0 ) * ( _lutSize - 1 );
+        const size_t index = std::min( size_t( x ), _lutSize - 2 );
+        const double t = x - double( index );
+
+        const auto& a = diffuse[ index ];
+        const auto& b = diffuse[ index + 1 ];
+        rgba[ 4 * i ] = float( a.getRed() + t * ( b.getRed() - a.getRed( )));
+        rgba[ 4 * i + 1 ] = float( a.getGreen() +
+                                   t * ( b.getGreen() - a.getGreen( )));
+        rgba[ 4 * i + 2 ] = float( a.getBlue() +
+                                   t * ( b.getBlue() - a.getBlue( )));
+        rgba[ 4 * i + 3 ] = float( alpha[ index ] +
+                                   t * ( alpha[ index + 1 ] - alpha[ index ] ));
+    }
+}
+
+template< class F > float _measure( const F& func )
+{
+    const auto start = std::chrono::high_resolution_clock::now();
+    func();
+    const std::chrono::duration< float > elapsed =
+        std::chrono::high_resolution_clock::now() - start;
+    return float( _count ) / 1000000.f / elapsed.count();
+}
+}
+
+BOOST_AUTO_TEST_CASE( classify )
+{
+    MaterialLUT lut;
+    double range[] = { -1.0, 1.0 };
+    lut.setRange( range );
+
+    Colors diffuse;
+    std::vector< float > alpha;
+    for( size_t i = 0; i < _lutSize; ++i )
+    {
+        const float value = float( i ) / float( _lutSize - 1 );
+        diffuse.push_back( { value, 1.f - value, value * value } );
+        alpha.push_back( value );
+    }
+    lut.setDiffuse( diffuse );
+    lut.setAlpha( alpha );
+
+    std::vector< float > values( _count );
+    for( size_t i = 0; i < _count; ++i )
+        values[i] = std::sin( float( i ));
+
+    std::vector< float > expected( 4 * _count );
+    std::vector< float > rgba( 4 * _count );
+
+    const float scalar = _measure( [&] {
+        _classifyScalar( diffuse, alpha, range, values.data(), _count,
+                         expected.data( ));
+    });
+    const float nearest = _measure( [&] {
+        lut.classify( values.data(), _count, rgba.data(), nullptr,
+                      MaterialLUT::Interpolation::nearest );
+    });
+    const float linear = _measure( [&] {
+        lut.classify( values.data(), _count, rgba.data( ));
+    });
+
+    for( size_t i = 0; i < rgba.size(); i += 997 )
+        BOOST_CHECK_SMALL( rgba[i] - expected[i], 0.001f );
+
+    std::cout << "Mvalues/s scalar double: " << std::setw( 8 ) << scalar
+              << ", classify nearest: " << std::setw( 8 ) << nearest
+              << ", classify linear: " << std::setw( 8 ) << linear
+              << std::endl;
+}
@@ -0,0 +1,125 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#define BOOST_TEST_MODULE qt_arrayModel
+
+#include <lexisqt/ArrayModel.h>
+#include <boost/test/unit_test.hpp>
+
+#include <QCoreApplication>
+
+using lexisqt::ArrayModel;
+
+namespace
+{
+struct Application
+{
+    Application()
+        : app( boost::unit_test::framework::master_test_suite().argc,
+               boost::unit_test::framework::master_test_suite().argv )
+    {
+    }
+
+    QCoreApplication app;
+};
+
+struct Notifications
+{
+    explicit Notifications( ArrayModel& model )
+    {
+        QObject::connect( &model, &QAbstractItemModel::modelReset,
+                          [this] { ++resets; });
+        QObject::connect( &model, &ArrayModel::countChanged,
+                          [this] { ++countChanges; });
+        QObject::connect( &model, &QAbstractItemModel::dataChanged,
+                          [this]( const QModelIndex& topLeft,
+                                  const QModelIndex& bottomRight,
+                                  const QVector< int >& changedRoles )
+        {
+            ++dataChanges;
+            first = topLeft.row();
+            last = bottomRight.row();
+            roles = changedRoles;
+        });
+    }
+
+    size_t resets = 0;
+    size_t countChanges = 0;
+    size_t dataChanges = 0;
+    int first = -1;
+    int last = -1;
+    QVector< int > roles;
+};
+}
+
+BOOST_GLOBAL_FIXTURE( Application );
+
+BOOST_AUTO_TEST_CASE( reset )
+{
+    ArrayModel model;
+    Notifications notifications( model );
+
+    std::vector< float > values = { 1.f, 2.f, 3.f };
+    model.setValues( values.data(), values.size( ));
+    BOOST_CHECK_EQUAL( notifications.resets, 1 );
+    BOOST_CHECK_EQUAL( notifications.countChanges, 1 );
+    BOOST_CHECK_EQUAL( notifications.dataChanges, 0 );
+    BOOST_CHECK_EQUAL( model.rowCount(), 3 );
+    BOOST_CHECK_EQUAL( model.getCount(), 3 );
+    BOOST_CHECK_EQUAL( model.get( 2 ).toFloat(), 3.f );
+
+    // another type of the same size
+    const std::vector< uint32_t > ids = { 4, 5, 6 };
+    model.setValues( ids.data(), ids.size( ));
+    BOOST_CHECK_EQUAL( notifications.resets, 2 );
+    BOOST_CHECK_EQUAL( notifications.countChanges, 1 );
+    BOOST_CHECK_EQUAL( model.get( 0 ).toUInt(), 4u );
+
+    // another size
+    values.push_back( 4.f );
+    model.setValues( values.data(), values.size( ));
+    BOOST_CHECK_EQUAL( notifications.resets, 3 );
+    BOOST_CHECK_EQUAL( notifications.countChanges, 2 );
+    BOOST_CHECK_EQUAL( model.rowCount(), 4 );
+    BOOST_CHECK_EQUAL( notifications.dataChanges, 0 );
+
+    // out of range access
+    BOOST_CHECK_EQUAL( model.get( 4 ).toInt(), 0 );
+}
+
+BOOST_AUTO_TEST_CASE( changedRange )
+{
+    ArrayModel model;
+    Notifications notifications( model );
+
+    std::vector< double > values = { 1.0, 2.0, 3.0, 4.0, 5.0, 6.0 };
+    model.setValues( values.data(), values.size( ));
+
+    values[1] = 20.0;
+    values[3] = 40.0;
+    model.setValues( values.data(), values.size( ));
+    BOOST_CHECK_EQUAL( notifications.resets, 1 );
+    BOOST_CHECK_EQUAL( notifications.dataChanges, 1 );
+    BOOST_CHECK_EQUAL( notifications.first, 1 );
+    BOOST_CHECK_EQUAL( notifications.last, 3 );
+    BOOST_CHECK( notifications.roles.contains( ArrayModel::ValueRole ));
+    BOOST_CHECK( notifications.roles.contains( Qt::DisplayRole ));
+
+    BOOST_CHECK_EQUAL( model.data( model.index( 3 ), Qt::DisplayRole )
+                           .toDouble(), 40.0 );
+    BOOST_CHECK_EQUAL( model.data( model.index( 2 ), ArrayModel::ValueRole )
+                           .toDouble(), 3.0 );
+    BOOST_CHECK( !model.data( model.index( 2 ), Qt::EditRole ).isValid( ));
+
+    // unchanged values are not notified
+    model.setValues( values.data(), values.size( ));
+    BOOST_CHECK_EQUAL( notifications.dataChanges, 1 );
+    BOOST_CHECK_EQUAL( notifications.resets, 1 );
+
+    values[5] = 60.0;
+    model.setValues( values.data(), values.size( ));
+    BOOST_CHECK_EQUAL( notifications.dataChanges, 2 );
+    BOOST_CHECK_EQUAL( notifications.first, 5 );
+    BOOST_CHECK_EQUAL( notifications.last, 5 );
+}
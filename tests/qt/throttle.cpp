@@ -0,0 +1,150 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#define BOOST_TEST_MODULE qt_throttle
+
+#include <lexisqt/Throttle.h>
+#include <boost/test/unit_test.hpp>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+
+#include <cstring>
+
+namespace
+{
+struct Application
+{
+    Application()
+        : app( boost::unit_test::framework::master_test_suite().argc,
+               boost::unit_test::framework::master_test_suite().argv )
+    {
+    }
+
+    QCoreApplication app;
+};
+
+// Counts the deserializations of a uint32_t value
+class Counter : public servus::Serializable
+{
+public:
+    std::string getTypeName() const final { return "lexisqt::test::Counter"; }
+
+    uint32_t value = 0;
+    size_t nDeserialized = 0;
+
+private:
+    bool _fromBinary( const void* data, const size_t size ) final
+    {
+        if( size != sizeof( value ))
+            return false;
+        ::memcpy( &value, data, size );
+        ++nDeserialized;
+        return true;
+    }
+
+    Data _toBinary() const final
+    {
+        Data data;
+        data.ptr.reset( new uint32_t( value ));
+        data.size = sizeof( value );
+        return data;
+    }
+};
+
+// Processes events until the condition is met or a timeout occurred
+template< class F > bool _processEventsUntil( const F& condition )
+{
+    QElapsedTimer timer;
+    timer.start();
+    while( !condition() && timer.elapsed() < 5000 )
+        QCoreApplication::processEvents();
+    return condition();
+}
+
+void _processEventsFor( const qint64 milliseconds )
+{
+    QElapsedTimer timer;
+    timer.start();
+    while( timer.elapsed() < milliseconds )
+        QCoreApplication::processEvents();
+}
+}
+
+BOOST_GLOBAL_FIXTURE( Application );
+
+BOOST_AUTO_TEST_CASE( coalesce )
+{
+    Counter counter;
+    lexisqt::Throttle throttle( counter, 20 );
+    size_t nUpdated = 0;
+    QObject::connect( &throttle, &lexisqt::Throttle::updated,
+                      [&] { ++nUpdated; });
+
+    // updates are applied from the event loop, only the latest one
+    for( uint32_t i = 1; i <= 100; ++i )
+        throttle.update( &i, sizeof( i ));
+    BOOST_CHECK_EQUAL( counter.nDeserialized, 0 );
+    BOOST_CHECK( _processEventsUntil( [&] { return nUpdated == 1; }));
+    BOOST_CHECK_EQUAL( counter.nDeserialized, 1 );
+    BOOST_CHECK_EQUAL( counter.value, 100 );
+
+    // updates within the interval are delayed, then applied once
+    for( uint32_t i = 101; i <= 200; ++i )
+        throttle.update( &i, sizeof( i ));
+    BOOST_CHECK( _processEventsUntil( [&] { return nUpdated == 2; }));
+    BOOST_CHECK_EQUAL( counter.nDeserialized, 2 );
+    BOOST_CHECK_EQUAL( counter.value, 200 );
+
+    Counter event;
+    event.value = 4711;
+    throttle.update( event );
+    BOOST_CHECK( _processEventsUntil( [&] { return nUpdated == 3; }));
+    BOOST_CHECK_EQUAL( counter.value, 4711 );
+
+    _processEventsFor( 50 );
+    BOOST_CHECK_EQUAL( nUpdated, 3 );
+    BOOST_CHECK_EQUAL( counter.nDeserialized, 3 );
+}
+
+BOOST_AUTO_TEST_CASE( flushOnly )
+{
+    Counter counter;
+    lexisqt::Throttle throttle( counter, 0 );
+    size_t nUpdated = 0;
+    QObject::connect( &throttle, &lexisqt::Throttle::updated,
+                      [&] { ++nUpdated; });
+
+    for( uint32_t i = 1; i <= 10; ++i )
+        throttle.update( &i, sizeof( i ));
+
+    // without an interval the event loop does not apply updates
+    _processEventsFor( 50 );
+    BOOST_CHECK_EQUAL( counter.nDeserialized, 0 );
+
+    throttle.flush();
+    BOOST_CHECK_EQUAL( counter.nDeserialized, 1 );
+    BOOST_CHECK_EQUAL( counter.value, 10 );
+    BOOST_CHECK_EQUAL( nUpdated, 1 );
+
+    // nothing pending
+    throttle.flush();
+    BOOST_CHECK_EQUAL( counter.nDeserialized, 1 );
+    BOOST_CHECK_EQUAL( nUpdated, 1 );
+}
+
+BOOST_AUTO_TEST_CASE( rejectedUpdate )
+{
+    Counter counter;
+    lexisqt::Throttle throttle( counter, 0 );
+    size_t nUpdated = 0;
+    QObject::connect( &throttle, &lexisqt::Throttle::updated,
+                      [&] { ++nUpdated; });
+
+    const uint8_t truncated = 42;
+    throttle.update( &truncated, sizeof( truncated ));
+    throttle.flush();
+    BOOST_CHECK_EQUAL( counter.nDeserialized, 0 );
+    BOOST_CHECK_EQUAL( nUpdated, 0 );
+}
@@ -0,0 +1,83 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#define BOOST_TEST_MODULE Animation
+
+#include <lexis/render/Animation.h>
+#include <boost/test/unit_test.hpp>
+
+using lexis::render::Animation;
+using lexis::render::Frame;
+using std::chrono::milliseconds;
+
+BOOST_AUTO_TEST_CASE( playback )
+{
+    Animation animation( 10.0 );
+    animation.setFrame( Frame( 10, 12, 15, 1 ));
+    BOOST_CHECK_EQUAL( animation.getFrame().getCurrent(), 12 );
+
+    const auto start = Animation::Clock::now();
+    BOOST_CHECK( !animation.update( start ));
+    BOOST_CHECK( !animation.update( start + milliseconds( 50 )));
+
+    BOOST_CHECK( animation.update( start + milliseconds( 150 )));
+    BOOST_CHECK_EQUAL( animation.getFrame().getCurrent(), 13 );
+
+    // the remaining 50ms count towards the next step
+    BOOST_CHECK( animation.update( start + milliseconds( 200 )));
+    BOOST_CHECK_EQUAL( animation.getFrame().getCurrent(), 14 );
+
+    // wraps into [start, end)
+    BOOST_CHECK( animation.update( start + milliseconds( 400 )));
+    BOOST_CHECK_EQUAL( animation.getFrame().getCurrent(), 11 );
+}
+
+BOOST_AUTO_TEST_CASE( backwards )
+{
+    Animation animation( 1.0 );
+    animation.setFrame( Frame( 0, 1, 4, -3 ));
+
+    const auto start = Animation::Clock::now();
+    animation.update( start );
+    BOOST_CHECK( animation.update( start + std::chrono::seconds( 1 )));
+    BOOST_CHECK_EQUAL( animation.getFrame().getCurrent(), 2 );
+}
+
+BOOST_AUTO_TEST_CASE( paused )
+{
+    Animation animation;
+    animation.setFrame( Frame( 0, 1, 4, 0 ));
+
+    const auto start = Animation::Clock::now();
+    animation.update( start );
+    BOOST_CHECK( !animation.update( start + std::chrono::seconds( 1 )));
+    BOOST_CHECK_EQUAL( animation.getFrame().getCurrent(), 1 );
+    BOOST_CHECK( animation.getPrefetch( 3 ).getFrames().empty( ));
+}
+
+BOOST_AUTO_TEST_CASE( frameRange )
+{
+    Animation animation;
+    animation.setFrame( Frame( 0, 1, 100, 1 ));
+    BOOST_CHECK( animation.setFrameRange( { 5, 20 } ));
+    BOOST_CHECK_EQUAL( animation.getFrame().getStart(), 5 );
+    BOOST_CHECK_EQUAL( animation.getFrame().getEnd(), 20 );
+    BOOST_CHECK_EQUAL( animation.getFrame().getCurrent(), 16 );
+    BOOST_CHECK( !animation.setFrameRange( { 0, 50 } ));
+}
+
+BOOST_AUTO_TEST_CASE( lookahead )
+{
+    Animation animation;
+    animation.setFrame( Frame( 0, 2, 4, 1 ));
+
+    const std::vector< uint32_t > expected = { 3, 0 };
+    const auto prefetch = animation.getPrefetch( 2 );
+    const uint32_t* frames = prefetch.getFrames().data();
+    BOOST_CHECK_EQUAL_COLLECTIONS( frames, frames + prefetch.getFrames().size(),
+                                   expected.begin(), expected.end( ));
+
+    // at most all other frames of the loop
+    BOOST_CHECK_EQUAL( animation.getPrefetch( 10 ).getFrames().size(), 3 );
+}
@@ -39,3 +39,122 @@ BOOST_AUTO_TEST_CASE( testClipping )
     BOOST_CHECK( clipPlanes.isOutside( boxOutside ));
     BOOST_CHECK( !clipPlanes.isOutside( boxIntersect ));
 }
+
+BOOST_AUTO_TEST_CASE( applyPatch )
+{
+    lexis::render::ClipPlanes sender;
+    lexis::render::ClipPlanes receiver;
+    const lexis::render::ClipPlanes base = sender;
+
+    using Planes = std::vector< lexis::render::detail::Plane >;
+    Planes planes( sender.getPlanes().begin(), sender.getPlanes().end( ));
+    planes[2] = { { 0.0f, -1.0f, 0.0f }, 0.25f };
+    sender.setPlanes( planes );
+    sender.setVersion( 1 );
+
+    const auto patch = sender.diff( base );
+    BOOST_CHECK_EQUAL( patch.getStart(), 2 );
+    BOOST_CHECK_EQUAL( patch.getSize(), 6 );
+    BOOST_CHECK_EQUAL( patch.getPlanes().size(), 1 );
+
+    BOOST_CHECK( receiver.apply( patch ));
+    BOOST_CHECK( receiver == sender );
+
+    // the same patch does not apply twice
+    BOOST_CHECK( !receiver.apply( patch ));
+
+    // removing planes
+    const lexis::render::ClipPlanes previous = sender;
+    planes.resize( 4 );
+    sender.setPlanes( planes );
+    sender.setVersion( 2 );
+    BOOST_CHECK( receiver.apply( sender.diff( previous )));
+    BOOST_CHECK_EQUAL( receiver.getPlanes().size(), 4 );
+    BOOST_CHECK( receiver == sender );
+}
+
+BOOST_AUTO_TEST_CASE( transform )
+{
+    const lexis::render::ClipPlanes clipPlanes;
+
+    // world to view: translate by +10 in x
+    const double translation[16] = { 1, 0, 0, 0,  0, 1, 0, 0,  0, 0, 1, 0,
+                                     10, 0, 0, 1 };
+    // copy, the result is only valid until the next transform
+    const lexis::render::ViewClipPlanes translated =
+        clipPlanes.transform( translation );
+    BOOST_CHECK_EQUAL( translated.getNumBlocks(), 2 );
+    BOOST_CHECK( !translated.isOutside( vmml::AABBf(
+                     vmml::Vector3f( 9.7f, -0.3f, -0.3f ),
+                     vmml::Vector3f( 10.3f, 0.3f, 0.3f ))));
+    BOOST_CHECK( translated.isOutside( vmml::AABBf(
+                     vmml::Vector3f( 10.8f, -0.3f, -0.3f ),
+                     vmml::Vector3f( 10.9f, 0.3f, 0.3f ))));
+    BOOST_CHECK( !translated.isOutside( vmml::AABBf(
+                     vmml::Vector3f( 10.3f, 0.3f, 0.3f ),
+                     vmml::Vector3f( 10.9f, 0.9f, 0.9f ))));
+
+    // a batch of views: identity, translation, rotation by 90 degrees around z
+    // and a singular matrix
+    const double matrices[64] = { 1, 0, 0, 0,  0, 1, 0, 0,  0, 0, 1, 0,
+                                  0, 0, 0, 1,
+                                  1, 0, 0, 0,  0, 1, 0, 0,  0, 0, 1, 0,
+                                  10, 0, 0, 1,
+                                  0, 1, 0, 0,  -1, 0, 0, 0,  0, 0, 1, 0,
+                                  0, 0, 0, 1,
+                                  0 };
+    const std::vector< lexis::render::ViewClipPlanes > views =
+        clipPlanes.transform( matrices, 4 );
+    BOOST_REQUIRE_EQUAL( views.size(), 4 );
+
+    // a box at world x = 0.8 is outside, at world y = 0.8 as well, but rotated
+    // into view y and -x respectively
+    const vmml::AABBf worldX( vmml::Vector3f( 0.8f, -0.1f, -0.1f ),
+                              vmml::Vector3f( 0.9f, 0.1f, 0.1f ));
+    const vmml::AABBf viewY( vmml::Vector3f( -0.1f, 0.8f, -0.1f ),
+                             vmml::Vector3f( 0.1f, 0.9f, 0.1f ));
+    const vmml::AABBf viewMinusX( vmml::Vector3f( -0.9f, -0.1f, -0.1f ),
+                                  vmml::Vector3f( -0.8f, 0.1f, 0.1f ));
+    const vmml::AABBf inside( vmml::Vector3f( -0.3f, -0.3f, -0.3f ),
+                              vmml::Vector3f( 0.3f, 0.3f, 0.3f ));
+
+    BOOST_CHECK( views[0].isOutside( worldX ));
+    BOOST_CHECK( !views[0].isOutside( inside ));
+    BOOST_CHECK( views[0].blocks == clipPlanes.transform( matrices ).blocks );
+
+    BOOST_CHECK( views[1].blocks == translated.blocks );
+
+    BOOST_CHECK( views[2].isOutside( viewY ));
+    BOOST_CHECK( views[2].isOutside( viewMinusX ));
+    BOOST_CHECK( !views[2].isOutside( inside ));
+
+    BOOST_CHECK( !views[3].isOutside( worldX ));
+
+    // results match the world space test for random boxes and planes
+    lexis::render::ClipPlanes random;
+    std::vector< lexis::render::detail::Plane > planes;
+    for( size_t i = 0; i < 7; ++i )
+        planes.push_back( { { float( i % 3 ) - 1.f, float( i % 2 ),
+                              float( i % 5 ) * 0.5f - 1.f }, float( i ) * 0.1f });
+    random.setPlanes( planes );
+    const auto& randomViews = random.transform( matrices, 3 );
+    BOOST_CHECK_EQUAL( randomViews[0].getNumBlocks(), 2 );
+    for( int x = -10; x <= 10; ++x )
+    {
+        for( int y = -10; y <= 10; ++y )
+        {
+            const float minX = x * 0.2f + 0.03f;
+            const float minY = y * 0.2f + 0.03f;
+            const vmml::AABBf box( vmml::Vector3f( minX, minY, -0.1f ),
+                                   vmml::Vector3f( minX + 0.13f, minY + 0.13f,
+                                                   0.1f ));
+            const vmml::AABBf translatedBox(
+                vmml::Vector3f( minX + 10.f, minY, -0.1f ),
+                vmml::Vector3f( minX + 10.13f, minY + 0.13f, 0.1f ));
+            BOOST_CHECK_EQUAL( randomViews[0].isOutside( box ),
+                               random.isOutside( box ));
+            BOOST_CHECK_EQUAL( randomViews[1].isOutside( translatedBox ),
+                               random.isOutside( box ));
+        }
+    }
+}
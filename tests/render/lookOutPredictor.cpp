@@ -0,0 +1,97 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#define BOOST_TEST_MODULE LookOutPredictor
+
+#include <lexis/render/LookOutPredictor.h>
+#include <boost/test/unit_test.hpp>
+#include <vmmlib/vector.hpp>
+
+#include <cmath>
+
+using lexis::render::LookOut;
+using lexis::render::LookOutPredictor;
+using std::chrono::milliseconds;
+
+namespace
+{
+const double _pi = 3.14159265358979323846;
+
+// rotation around the y axis followed by a translation along x
+LookOut _createLookOut( const double angle, const double x )
+{
+    double matrix[16] = { std::cos( angle ), 0, -std::sin( angle ), 0,
+                          0, 1, 0, 0,
+                          std::sin( angle ), 0, std::cos( angle ), 0,
+                          x, 0, 0, 1 };
+    LookOut lookOut;
+    lookOut.setMatrix( matrix );
+    return lookOut;
+}
+
+void _checkEqual( const LookOut& lookOut, const LookOut& expected )
+{
+    for( size_t i = 0; i < 16; ++i )
+        BOOST_CHECK_SMALL( lookOut.getMatrix()[i] - expected.getMatrix()[i],
+                           1e-9 );
+}
+}
+
+BOOST_AUTO_TEST_CASE( singleUpdate )
+{
+    LookOutPredictor predictor;
+    _checkEqual( predictor.predict(), _createLookOut( 0, 0 ));
+
+    const auto lookOut = _createLookOut( 0.5, 2 );
+    predictor.update( lookOut );
+    _checkEqual( predictor.predict(), lookOut );
+    BOOST_CHECK_EQUAL( predictor.getLinearVelocity().x(), 0.0 );
+}
+
+BOOST_AUTO_TEST_CASE( interpolate )
+{
+    LookOutPredictor predictor;
+    const auto start = LookOutPredictor::Clock::now();
+    predictor.update( _createLookOut( 0, 0 ), start );
+    predictor.update( _createLookOut( _pi / 2, 1 ), start + milliseconds( 100 ));
+
+    _checkEqual( predictor.predict( start ), _createLookOut( 0, 0 ));
+    _checkEqual( predictor.predict( start + milliseconds( 50 )),
+                 _createLookOut( _pi / 4, 0.5 ));
+    _checkEqual( predictor.predict( start + milliseconds( 100 )),
+                 _createLookOut( _pi / 2, 1 ));
+
+    BOOST_CHECK_CLOSE( predictor.getLinearVelocity().x(), 10.0, 1e-6 );
+    BOOST_CHECK_CLOSE( predictor.getAngularVelocity().y(), 5 * _pi, 1e-6 );
+    BOOST_CHECK_SMALL( predictor.getAngularVelocity().x(), 1e-9 );
+}
+
+BOOST_AUTO_TEST_CASE( extrapolate )
+{
+    LookOutPredictor predictor( milliseconds( 0 ), milliseconds( 100 ));
+    const auto start = LookOutPredictor::Clock::now();
+    predictor.update( _createLookOut( 0, 0 ), start );
+    predictor.update( _createLookOut( 0.1, 1 ), start + milliseconds( 100 ));
+
+    _checkEqual( predictor.predict( start + milliseconds( 150 )),
+                 _createLookOut( 0.15, 1.5 ));
+
+    // limited to maxExtrapolation after the latest update
+    _checkEqual( predictor.predict( start + milliseconds( 1000 )),
+                 _createLookOut( 0.2, 2 ));
+}
+
+BOOST_AUTO_TEST_CASE( delay )
+{
+    LookOutPredictor predictor( milliseconds( 100 ));
+    const auto start = LookOutPredictor::Clock::now();
+    predictor.update( _createLookOut( 0, 0 ), start );
+    predictor.update( _createLookOut( 0, 1 ), start + milliseconds( 100 ));
+
+    _checkEqual( predictor.predict( start + milliseconds( 150 )),
+                 _createLookOut( 0, 0.5 ));
+
+    predictor.reset();
+    _checkEqual( predictor.predict(), _createLookOut( 0, 0 ));
+}
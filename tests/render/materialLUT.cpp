@@ -0,0 +1,329 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#define BOOST_TEST_MODULE MaterialLUT
+
+#include <lexis/render/MaterialLUT.h>
+#include <boost/test/unit_test.hpp>
+
+#include <limits>
+#include <thread>
+
+using lexis::render::MaterialLUT;
+using Texture = lexis::render::MaterialLUT::Texture;
+
+BOOST_AUTO_TEST_CASE( emptyTexture )
+{
+    const MaterialLUT lut;
+    const auto& diffuse = lut.getTexture( 2 );
+    const std::vector< float > expected = { 0, 0, 0, 1, 0, 0, 0, 1 };
+    BOOST_CHECK_EQUAL_COLLECTIONS( diffuse.begin(), diffuse.end(),
+                                   expected.begin(), expected.end( ));
+
+    const auto& emission = lut.getTexture( 2, Texture::emissionContribution );
+    BOOST_CHECK_EQUAL( emission.size(), 8 );
+    for( const float value : emission )
+        BOOST_CHECK_EQUAL( value, 0.f );
+}
+
+BOOST_AUTO_TEST_CASE( resample )
+{
+    MaterialLUT lut;
+    lut.setDiffuse( {{ 0.f, 0.f, 1.f }, { 1.f, 0.5f, 0.f }} );
+    lut.setAlpha( { 0.f, 1.f, 0.f } );
+    lut.setEmission( {{ 0.25f, 0.25f, 0.25f }} );
+
+    const auto& rgba = lut.getTexture( 5 );
+    const std::vector< float > expected = { 0.f,   0.f,    1.f,   0.f,
+                                            0.25f, 0.125f, 0.75f, 0.5f,
+                                            0.5f,  0.25f,  0.5f,  1.f,
+                                            0.75f, 0.375f, 0.25f, 0.5f,
+                                            1.f,   0.5f,   0.f,   0.f };
+    BOOST_CHECK_EQUAL_COLLECTIONS( rgba.begin(), rgba.end(),
+                                   expected.begin(), expected.end( ));
+
+    const auto& rgba8 = lut.getTexture8( 5 );
+    BOOST_REQUIRE_EQUAL( rgba8.size(), 20 );
+    BOOST_CHECK_EQUAL( int( rgba8[0] ), 0 );
+    BOOST_CHECK_EQUAL( int( rgba8[4] ), 64 );
+    BOOST_CHECK_EQUAL( int( rgba8[11] ), 255 );
+
+    const auto& emission = lut.getTexture( 3, Texture::emissionContribution );
+    const std::vector< float > expectedEmission = { 0.25f, 0.25f, 0.25f, 0.f,
+                                                    0.25f, 0.25f, 0.25f, 0.f,
+                                                    0.25f, 0.25f, 0.25f, 0.f };
+    BOOST_CHECK_EQUAL_COLLECTIONS( emission.begin(), emission.end(),
+                                   expectedEmission.begin(),
+                                   expectedEmission.end( ));
+}
+
+BOOST_AUTO_TEST_CASE( cache )
+{
+    MaterialLUT lut;
+    lut.setAlpha( { 0.f, 1.f } );
+
+    const auto* texture = &lut.getTexture( 256 );
+    const float* data = texture->data();
+    BOOST_CHECK_EQUAL( (*texture)[ 4 * 255 + 3 ], 1.f );
+
+    // unchanged LUT and size returns the cached texture
+    BOOST_CHECK_EQUAL( lut.getTexture( 256 ).data(), data );
+
+    lut.setAlpha( { 1.f, 0.f } );
+    BOOST_CHECK_EQUAL( lut.getTexture( 256 )[ 4 * 255 + 3 ], 0.f );
+
+    BOOST_CHECK_EQUAL( lut.getTexture( 16 ).size(), 64 );
+    BOOST_CHECK_EQUAL( lut.getTexture( 16 )[ 3 ], 1.f );
+}
+
+BOOST_AUTO_TEST_CASE( cacheClassify )
+{
+    MaterialLUT lut;
+    double range[] = { 0.0, 1.0 };
+    lut.setRange( range );
+    lut.setAlpha( { 0.f, 1.f } );
+    const std::vector< float > values = { 0.f, 0.5f, 1.f };
+    std::vector< float > rgba( 4 * values.size( ));
+
+    // classify() at the LUT size does not evict the texture of another size
+    const auto& texture = lut.getTexture( 256 );
+    const float* data = texture.data();
+    for( size_t i = 0; i < 3; ++i )
+    {
+        lut.classify( values.data(), values.size(), rgba.data( ));
+        BOOST_CHECK_EQUAL( rgba[ 4 + 3 ], 0.5f );
+        BOOST_CHECK_EQUAL( texture.size(), 4 * 256 );
+        BOOST_CHECK_EQUAL( &lut.getTexture( 256 ), &texture );
+        BOOST_CHECK_EQUAL( lut.getTexture( 256 ).data(), data );
+        BOOST_CHECK_EQUAL( texture[ 4 * 255 + 3 ], 1.f );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( classify )
+{
+    MaterialLUT lut;
+    double range[] = { 10.0, 20.0 };
+    lut.setRange( range );
+    lut.setDiffuse( {{ 0.f, 0.f, 0.f }, { 1.f, 1.f, 1.f }, { 1.f, 0.f, 0.f }} );
+    lut.setAlpha( { 0.f, 1.f, 1.f } );
+    lut.setContribution( { 0.5f } );
+
+    const std::vector< float > values = { 0.f, 10.f, 12.5f, 15.f, 17.5f, 30.f };
+    std::vector< float > rgba( 4 * values.size( ));
+    std::vector< float > emission( 4 * values.size( ));
+
+    lut.classify( values.data(), values.size(), rgba.data(), emission.data( ));
+    const std::vector< float > expected = { 0.f,  0.f,  0.f,  0.f,
+                                            0.f,  0.f,  0.f,  0.f,
+                                            0.5f, 0.5f, 0.5f, 0.5f,
+                                            1.f,  1.f,  1.f,  1.f,
+                                            1.f,  0.5f, 0.5f, 1.f,
+                                            1.f,  0.f,  0.f,  1.f };
+    BOOST_CHECK_EQUAL_COLLECTIONS( rgba.begin(), rgba.end(),
+                                   expected.begin(), expected.end( ));
+    for( size_t i = 0; i < values.size(); ++i )
+        BOOST_CHECK_EQUAL( emission[ 4 * i + 3 ], 0.5f );
+
+    lut.classify( values.data(), values.size(), rgba.data(), nullptr,
+                  MaterialLUT::Interpolation::nearest );
+    BOOST_CHECK_EQUAL( rgba[ 4 * 2 + 3 ], 1.f );  // 12.5 rounds to entry 1
+    BOOST_CHECK_EQUAL( rgba[ 4 * 4 + 1 ], 0.f );  // 17.5 rounds to entry 2
+
+    const std::vector< uint16_t > shorts = { 5, 15, 25 };
+    lut.classify( shorts.data(), shorts.size(), rgba.data( ));
+    BOOST_CHECK_EQUAL( rgba[3], 0.f );
+    BOOST_CHECK_EQUAL( rgba[ 4 + 3 ], 1.f );
+    BOOST_CHECK_EQUAL( rgba[ 8 ], 1.f );
+    BOOST_CHECK_EQUAL( rgba[ 9 ], 0.f );
+}
+
+BOOST_AUTO_TEST_CASE( classifyBatches )
+{
+    MaterialLUT lut;
+    double range[] = { 10.0, 20.0 };
+    lut.setRange( range );
+    lut.setDiffuse( {{ 0.f, 0.2f, 0.f }, { 1.f, 1.f, 0.5f }, { 1.f, 0.f, 0.f },
+                     { 0.3f, 0.4f, 1.f }} );
+    lut.setAlpha( { 0.f, 1.f, 0.25f, 0.75f } );
+
+    // batches of four values give the same results as single values
+    const float inf = std::numeric_limits< float >::infinity();
+    const std::vector< float > values = {
+        std::numeric_limits< float >::quiet_NaN(), -inf, inf, -5.f, 10.f,
+        11.f, 12.5f, 13.3f, 16.6f, 19.9f, 20.f, 1e30f, 14.f };
+    std::vector< uint16_t > shorts;
+    for( size_t i = 0; i < values.size(); ++i )
+        shorts.push_back( uint16_t( 8 + i ));
+
+    for( const auto interpolation : { MaterialLUT::Interpolation::nearest,
+                                      MaterialLUT::Interpolation::linear })
+    {
+        std::vector< float > rgba( 4 * values.size( ));
+        std::vector< float > rgbaShorts( 4 * values.size( ));
+        lut.classify( values.data(), values.size(), rgba.data(), nullptr,
+                      interpolation );
+        lut.classify( shorts.data(), shorts.size(), rgbaShorts.data(),
+                      nullptr, interpolation );
+        for( size_t i = 0; i < values.size(); ++i )
+        {
+            float single[4];
+            lut.classify( &values[i], 1, single, nullptr, interpolation );
+            for( size_t j = 0; j < 4; ++j )
+                BOOST_CHECK_CLOSE( rgba[ 4 * i + j ], single[j], 0.0001f );
+
+            lut.classify( &shorts[i], 1, single, nullptr, interpolation );
+            for( size_t j = 0; j < 4; ++j )
+                BOOST_CHECK_CLOSE( rgbaShorts[ 4 * i + j ], single[j],
+                                   0.0001f );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( classifyParallel )
+{
+    MaterialLUT lut;
+    double range[] = { 0.0, 1.0 };
+    lut.setRange( range );
+    lut.setAlpha( { 0.f, 1.f } );
+
+    const size_t count = 1 << 20;
+    std::vector< float > values( count );
+    for( size_t i = 0; i < count; ++i )
+        values[i] = float( i ) / float( count );
+
+    std::vector< float > rgba( 4 * count );
+    lut.classify( values.data(), count, rgba.data( ));
+    for( size_t i = 0; i < count; i += 4711 )
+        BOOST_CHECK_CLOSE( rgba[ 4 * i + 3 ], values[i], 0.0001f );
+
+    // concurrent calls on different LUTs share the worker threads
+    MaterialLUT inverse = lut;
+    inverse.setAlpha( { 1.f, 0.f } );
+    std::vector< float > inverseRGBA( 4 * count );
+    std::thread thread( [&]
+        { inverse.classify( values.data(), count, inverseRGBA.data( )); });
+    lut.classify( values.data(), count, rgba.data( ));
+    thread.join();
+    for( size_t i = 0; i < count; i += 4711 )
+    {
+        BOOST_CHECK_CLOSE( rgba[ 4 * i + 3 ], values[i], 0.0001f );
+        BOOST_CHECK_CLOSE( inverseRGBA[ 4 * i + 3 ] + values[i], 1.f,
+                           0.0001f );
+    }
+}
+
+namespace
+{
+using Colors = std::vector< lexis::render::detail::Color >;
+
+MaterialLUT _createLUT()
+{
+    MaterialLUT lut;
+    Colors colors;
+    std::vector< float > alpha;
+    for( size_t i = 0; i < 256; ++i )
+        colors.push_back( { float( i % 7 ) / 7.f, float( i % 3 ) / 3.f,
+                            float( i ) / 255.f } );
+    for( size_t i = 0; i < 100; ++i )
+        alpha.push_back( float( i % 11 ) / 11.f );
+    lut.setDiffuse( colors );
+    lut.setEmission( colors );
+    lut.setAlpha( alpha );
+    return lut;
+}
+
+template< class T >
+void _checkEqual( const std::vector< T >& a, const std::vector< T >& b )
+{
+    BOOST_CHECK_EQUAL_COLLECTIONS( a.begin(), a.end(), b.begin(), b.end( ));
+}
+
+// Classifies the full range of a LUT
+std::vector< float > _classify( const MaterialLUT& lut )
+{
+    std::vector< float > values( 1000 );
+    for( size_t i = 0; i < values.size(); ++i )
+        values[i] = float( lut.getRange()[0] + ( lut.getRange()[1] -
+                           lut.getRange()[0] ) * double( i ) / 999.0 );
+    std::vector< float > rgba( 4 * values.size( ));
+    std::vector< float > emission( 4 * values.size( ));
+    lut.classify( values.data(), values.size(), rgba.data(), emission.data( ));
+    rgba.insert( rgba.end(), emission.begin(), emission.end( ));
+    return rgba;
+}
+
+// Textures of a patched LUT match the ones baked from scratch
+void _checkTextures( const MaterialLUT& lut )
+{
+    MaterialLUT expected;
+    expected.setDiffuse( lut.getDiffuse( ));
+    expected.setEmission( lut.getEmission( ));
+    expected.setAlpha( lut.getAlpha( ));
+    expected.setContribution( lut.getContribution( ));
+    double range[] = { lut.getRange()[0], lut.getRange()[1] };
+    expected.setRange( range );
+
+    _checkEqual( lut.getTexture( 1000 ), expected.getTexture( 1000 ));
+    _checkEqual( lut.getTexture8( 1000 ), expected.getTexture8( 1000 ));
+    _checkEqual( lut.getTexture( 64, Texture::emissionContribution ),
+                 expected.getTexture( 64, Texture::emissionContribution ));
+    _checkEqual( _classify( lut ), _classify( expected ));
+}
+}
+
+BOOST_AUTO_TEST_CASE( applyPatch )
+{
+    MaterialLUT sender = _createLUT();
+    MaterialLUT receiver = sender;
+    receiver.getTexture8( 1000 );
+    receiver.getTexture( 64, Texture::emissionContribution );
+    _classify( receiver );
+
+    const MaterialLUT base = sender;
+    Colors diffuse( sender.getDiffuse().begin(), sender.getDiffuse().end( ));
+    diffuse[42] = { 1.f, 1.f, 1.f };
+    diffuse[43] = { 0.f, 1.f, 0.f };
+    sender.setDiffuse( diffuse );
+    sender.getAlpha()[99] = 0.5f;
+    sender.setVersion( sender.getVersion() + 1 );
+
+    const auto patch = sender.diff( base );
+    BOOST_CHECK_EQUAL( patch.getDiffuseStart(), 42 );
+    BOOST_CHECK_EQUAL( patch.getDiffuse().size(), 2 );
+    BOOST_CHECK_EQUAL( patch.getAlphaStart(), 99 );
+    BOOST_CHECK_EQUAL( patch.getAlpha().size(), 1 );
+    BOOST_CHECK( patch.getEmission().empty( ));
+    BOOST_CHECK( patch.getContribution().empty( ));
+
+    BOOST_CHECK( receiver.apply( patch ));
+    BOOST_CHECK( receiver == sender );
+    _checkTextures( receiver );
+
+    // the same patch does not apply twice
+    BOOST_CHECK( !receiver.apply( patch ));
+    BOOST_CHECK( receiver == sender );
+}
+
+BOOST_AUTO_TEST_CASE( applyPatchResize )
+{
+    MaterialLUT sender = _createLUT();
+    MaterialLUT receiver = sender;
+    receiver.getTexture( 1000 );
+    _classify( receiver );
+
+    const MaterialLUT base = sender;
+    std::vector< float > alpha = { 0.f, 1.f };
+    sender.setAlpha( alpha );
+    sender.setContribution( alpha );
+    sender.setVersion( 7 );
+
+    BOOST_CHECK( receiver.apply( sender.diff( base )));
+    BOOST_CHECK( receiver == sender );
+    _checkTextures( receiver );
+
+    // patch of another base version is rejected
+    MaterialLUT other = _createLUT();
+    BOOST_CHECK( !other.apply( sender.diff( sender )));
+    BOOST_CHECK( other == _createLUT( ));
+}
@@ -0,0 +1,106 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#define BOOST_TEST_MODULE ResolutionController
+
+#include <lexis/render/ResolutionController.h>
+#include <boost/test/unit_test.hpp>
+
+using lexis::render::ResolutionController;
+using lexis::render::Viewport;
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+
+namespace
+{
+// Renderer taking fullFrameTime at full resolution, proportional to the pixels
+microseconds _render( const ResolutionController& controller,
+                      const milliseconds fullFrameTime )
+{
+    const double scale = controller.getScale();
+    return microseconds( int64_t( 1000.0 * fullFrameTime.count() * scale *
+                                  scale ));
+}
+
+ResolutionController _createController()
+{
+    ResolutionController controller( milliseconds( 33 ));
+    uint32_t size[] = { 1920, 1080 };
+    Viewport viewport;
+    viewport.setSize( size );
+    controller.setViewport( viewport );
+    return controller;
+}
+}
+
+BOOST_AUTO_TEST_CASE( fullResolution )
+{
+    ResolutionController controller = _createController();
+    for( size_t i = 0; i < 10; ++i )
+        BOOST_CHECK( !controller.update( milliseconds( 20 )));
+    BOOST_CHECK_EQUAL( controller.getScale(), 1.f );
+
+    const Viewport viewport = controller.getRenderViewport();
+    BOOST_CHECK_EQUAL( viewport.getSize()[0], 1920 );
+    BOOST_CHECK_EQUAL( viewport.getSize()[1], 1080 );
+}
+
+BOOST_AUTO_TEST_CASE( heavyScene )
+{
+    ResolutionController controller = _createController();
+    for( size_t i = 0; i < 50; ++i )
+        controller.update( _render( controller, milliseconds( 132 )));
+
+    // a quarter of the pixels renders in 33 ms
+    const microseconds frameTime = _render( controller, milliseconds( 132 ));
+    BOOST_CHECK_LE( frameTime.count(), 33000 * 1.1 );
+    BOOST_CHECK_GE( frameTime.count(), 33000 * 0.7 );
+
+    const Viewport viewport = controller.getRenderViewport();
+    BOOST_CHECK_LT( viewport.getSize()[0], 1920 );
+    BOOST_CHECK_EQUAL( viewport.getSize()[0],
+                       uint32_t( 1920 * controller.getScale() + 0.5f ));
+
+    // stable within the hysteresis band
+    const float scale = controller.getScale();
+    for( size_t i = 0; i < 50; ++i )
+        BOOST_CHECK( !controller.update( _render( controller,
+                                                  milliseconds( 120 + i % 20 ))));
+    BOOST_CHECK_EQUAL( controller.getScale(), scale );
+
+    // lighter scene increases the scale again
+    for( size_t i = 0; i < 50; ++i )
+        controller.update( _render( controller, milliseconds( 20 )));
+    BOOST_CHECK_EQUAL( controller.getScale(), 1.f );
+}
+
+BOOST_AUTO_TEST_CASE( scaleRange )
+{
+    ResolutionController controller = _createController();
+    controller.setScaleRange( 0.5f, 1.f );
+    for( size_t i = 0; i < 50; ++i )
+        controller.update( _render( controller, milliseconds( 1000 )));
+    BOOST_CHECK_EQUAL( controller.getScale(), 0.5f );
+}
+
+BOOST_AUTO_TEST_CASE( stopInteraction )
+{
+    ResolutionController controller = _createController();
+    for( size_t i = 0; i < 50; ++i )
+        controller.update( _render( controller, milliseconds( 132 )));
+    const float scale = controller.getScale();
+    BOOST_CHECK_LT( scale, 1.f );
+
+    // full resolution when the camera stops
+    BOOST_CHECK( controller.update( _render( controller, milliseconds( 132 )),
+                                    false ));
+    BOOST_CHECK_EQUAL( controller.getScale(), 1.f );
+    BOOST_CHECK_EQUAL( controller.getRenderViewport().getSize()[0], 1920 );
+    BOOST_CHECK( !controller.update( _render( controller, milliseconds( 132 )),
+                                     false ));
+
+    // and back to the interactive scale when it moves again
+    BOOST_CHECK( controller.update( _render( controller, milliseconds( 132 ))));
+    BOOST_CHECK_EQUAL( controller.getScale(), scale );
+}
@@ -0,0 +1,153 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#define BOOST_TEST_MODULE StreamController
+
+#include <lexis/render/StreamController.h>
+#include <boost/test/unit_test.hpp>
+
+using lexis::render::Stream;
+using lexis::render::StreamController;
+using lexis::render::StreamFeedback;
+
+namespace
+{
+const double _mb = 1024.0 * 1024.0;
+
+// feedback of a receiver displaying at fps, limited by the transport
+StreamFeedback _feedback( const double fps, const double latency,
+                          const double decodeTime = 0.005 )
+{
+    StreamFeedback feedback;
+    feedback.setBandwidth( 10.0 * _mb );
+    feedback.setDecodeTime( decodeTime );
+    feedback.setLatency( latency );
+    feedback.setFrameRate( fps );
+    return feedback;
+}
+}
+
+BOOST_AUTO_TEST_CASE( decreaseQuality )
+{
+    StreamController controller( 30.0 );
+    Stream stream;
+    stream.setQuality( 80 );
+
+    BOOST_CHECK( controller.update( _feedback( 15.0, 0.1 ), stream ));
+    BOOST_CHECK_EQUAL( stream.getQuality(), 60 );
+    BOOST_CHECK( stream.getCompression( ));
+
+    for( size_t i = 0; i < 10; ++i )
+        controller.update( _feedback( 15.0, 0.1 ), stream );
+    BOOST_CHECK_EQUAL( stream.getQuality(), controller.getMinQuality( ));
+    BOOST_CHECK( !controller.update( _feedback( 15.0, 0.1 ), stream ));
+}
+
+BOOST_AUTO_TEST_CASE( senderLimited )
+{
+    // slow frame rate with short latency is not caused by the stream
+    StreamController controller( 30.0 );
+    Stream stream;
+    BOOST_CHECK( !controller.update( _feedback( 10.0, 0.01 ), stream ));
+    BOOST_CHECK_EQUAL( stream.getQuality(), 80 );
+}
+
+BOOST_AUTO_TEST_CASE( increaseQuality )
+{
+    StreamController controller( 30.0 );
+    controller.setQualityRange( 30, 90 );
+    Stream stream;
+    stream.setQuality( 50 );
+
+    // delayed by a few updates meeting the target
+    BOOST_CHECK( !controller.update( _feedback( 30.0, 0.02 ), stream ));
+    BOOST_CHECK( !controller.update( _feedback( 30.0, 0.02 ), stream ));
+    BOOST_CHECK( controller.update( _feedback( 30.0, 0.02 ), stream ));
+    BOOST_CHECK_EQUAL( stream.getQuality(), 55 );
+
+    for( size_t i = 0; i < 100; ++i )
+        controller.update( _feedback( 30.0, 0.02 ), stream );
+    BOOST_CHECK_EQUAL( stream.getQuality(), 90 );
+    BOOST_CHECK( stream.getCompression( ));
+
+    // no increase when the link is saturated
+    controller.setMaxBandwidth( 11.0 * _mb );
+    stream.setQuality( 60 );
+    for( size_t i = 0; i < 10; ++i )
+        BOOST_CHECK( !controller.update( _feedback( 30.0, 0.02 ), stream ));
+    BOOST_CHECK_EQUAL( stream.getQuality(), 60 );
+}
+
+BOOST_AUTO_TEST_CASE( compression )
+{
+    StreamController controller( 30.0 );
+    controller.setMaxBandwidth( 1000.0 * _mb );
+    Stream stream;
+    stream.setQuality( controller.getMaxQuality( ));
+
+    // decoding limits the receiver at maximum quality, the link has capacity
+    const StreamFeedback decodeLimited = _feedback( 30.0, 0.03, 0.025 );
+    for( size_t i = 0; i < 3; ++i )
+        controller.update( decodeLimited, stream );
+    BOOST_CHECK( !stream.getCompression( ));
+
+    // uncompressed saturates the link, compress and stay compressed
+    BOOST_CHECK( controller.update( _feedback( 10.0, 0.2 ), stream ));
+    BOOST_CHECK( stream.getCompression( ));
+    BOOST_CHECK_EQUAL( stream.getQuality(), controller.getMaxQuality( ));
+    for( size_t i = 0; i < 10; ++i )
+        controller.update( decodeLimited, stream );
+    BOOST_CHECK( stream.getCompression( ));
+}
+
+BOOST_AUTO_TEST_CASE( decodeBound )
+{
+    StreamController controller( 30.0 );
+    controller.setMaxBandwidth( 1000.0 * _mb );
+    Stream stream;
+    stream.setQuality( 60 );
+
+    // decoding dominates the latency and slows the receiver below target
+    const StreamFeedback decodeLimited = _feedback( 20.0, 0.06, 0.04 );
+    BOOST_CHECK( controller.update( decodeLimited, stream ));
+    BOOST_CHECK( !stream.getCompression( ));
+    BOOST_CHECK_EQUAL( stream.getQuality(), 60 );
+
+    // without a known link bandwidth, only the quality can be lowered
+    StreamController unknownLink( 30.0 );
+    Stream compressed;
+    compressed.setQuality( 60 );
+    BOOST_CHECK( unknownLink.update( decodeLimited, compressed ));
+    BOOST_CHECK( compressed.getCompression( ));
+    BOOST_CHECK_EQUAL( compressed.getQuality(), 45 );
+}
+
+BOOST_AUTO_TEST_CASE( retryUncompressed )
+{
+    StreamController controller( 30.0 );
+    controller.setMaxBandwidth( 1000.0 * _mb );
+    Stream stream;
+    const StreamFeedback decodeLimited = _feedback( 20.0, 0.06, 0.04 );
+
+    // a congested link compresses the stream
+    BOOST_CHECK( controller.update( decodeLimited, stream ));
+    BOOST_CHECK( !stream.getCompression( ));
+    BOOST_CHECK( controller.update( _feedback( 10.0, 0.2 ), stream ));
+    BOOST_CHECK( stream.getCompression( ));
+    BOOST_CHECK( controller.update( decodeLimited, stream ));
+    BOOST_CHECK( stream.getCompression( ));
+
+    // a new link bandwidth allows to try uncompressed again
+    controller.setMaxBandwidth( 500.0 * _mb );
+    BOOST_CHECK( controller.update( decodeLimited, stream ));
+    BOOST_CHECK( !stream.getCompression( ));
+
+    // as does a longer recovery from the congestion
+    BOOST_CHECK( controller.update( _feedback( 10.0, 0.2 ), stream ));
+    BOOST_CHECK( stream.getCompression( ));
+    for( size_t i = 0; i < 100; ++i )
+        controller.update( _feedback( 30.0, 0.02 ), stream );
+    BOOST_CHECK( controller.update( decodeLimited, stream ));
+    BOOST_CHECK( !stream.getCompression( ));
+}
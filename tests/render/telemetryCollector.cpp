@@ -0,0 +1,157 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#define BOOST_TEST_MODULE TelemetryCollector
+
+#include <lexis/render/TelemetryCollector.h>
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <thread>
+
+using lexis::render::Stage;
+using lexis::render::Telemetry;
+using lexis::render::TelemetryCollector;
+using std::chrono::milliseconds;
+
+BOOST_AUTO_TEST_CASE( empty )
+{
+    TelemetryCollector collector;
+    const Telemetry telemetry = collector.collect();
+    BOOST_CHECK_EQUAL( telemetry.getFrames(), 0 );
+    BOOST_CHECK_EQUAL( telemetry.getAverageFrameTime(), 0.0 );
+    BOOST_CHECK_EQUAL( telemetry.getCacheHitRate(), 0.0 );
+    BOOST_CHECK_EQUAL( telemetry.getFrameTimes().size(), 50 );
+    BOOST_CHECK( telemetry.getFrameTimeHistogram().isEmpty( ));
+}
+
+BOOST_AUTO_TEST_CASE( collect )
+{
+    TelemetryCollector collector( milliseconds( 100 ), 10 );
+    auto& recorder = collector.createRecorder();
+    recorder.addFrame( milliseconds( 15 ));
+    recorder.addFrame( milliseconds( 25 ));
+    recorder.addFrame( milliseconds( 500 )); // counted in the last bin
+    recorder.addStageTime( Stage::Render, milliseconds( 30 ));
+    recorder.addStageTime( Stage::Cull, milliseconds( 3 ));
+    recorder.addBricks( 100, 300 );
+    recorder.addBytesLoaded( 1024 );
+    recorder.addCacheRequests( 75, 25 );
+
+    const Telemetry telemetry = collector.collect();
+    BOOST_CHECK_EQUAL( telemetry.getFrames(), 3 );
+    BOOST_CHECK_CLOSE( telemetry.getAverageFrameTime(), 0.18, 0.0001 );
+    BOOST_CHECK_CLOSE( telemetry.getAverageStageTime( Stage::Render ), 0.01,
+                       0.0001 );
+    BOOST_CHECK_CLOSE( telemetry.getAverageStageTime( Stage::Cull ), 0.001,
+                       0.0001 );
+    BOOST_CHECK_EQUAL( telemetry.getAverageStageTime( Stage::Load ), 0.0 );
+    BOOST_CHECK_EQUAL( telemetry.getVisibleBricks(), 100 );
+    BOOST_CHECK_EQUAL( telemetry.getCulledBricks(), 300 );
+    BOOST_CHECK_EQUAL( telemetry.getBytesLoaded(), 1024 );
+    BOOST_CHECK_EQUAL( telemetry.getCacheHitRate(), 0.75 );
+
+    const auto histogram = telemetry.getFrameTimeHistogram();
+    BOOST_CHECK_EQUAL( histogram.getSum(), 3 );
+    BOOST_CHECK_EQUAL( histogram.getMin(), 0.f );
+    BOOST_CHECK_CLOSE( histogram.getMax(), 0.1f, 0.0001f );
+    BOOST_CHECK_EQUAL( histogram.getBins()[1], 1 );
+    BOOST_CHECK_EQUAL( histogram.getBins()[2], 1 );
+    BOOST_CHECK_EQUAL( histogram.getBins()[9], 1 );
+
+    // only new data in the next collection
+    recorder.addFrame( milliseconds( 5 ));
+    const Telemetry next = collector.collect();
+    BOOST_CHECK_EQUAL( next.getFrames(), 1 );
+    BOOST_CHECK_EQUAL( next.getVisibleBricks(), 0 );
+    BOOST_CHECK_EQUAL( next.getFrameTimeHistogram().getBins()[0], 1 );
+}
+
+BOOST_AUTO_TEST_CASE( concurrentRecorders )
+{
+    TelemetryCollector collector;
+    const size_t nThreads = 4;
+    const size_t nFrames = 10000;
+
+    std::vector< std::thread > threads;
+    for( size_t i = 0; i < nThreads; ++i )
+    {
+        threads.emplace_back( [&]
+        {
+            auto& recorder = collector.createRecorder();
+            for( size_t j = 0; j < nFrames; ++j )
+            {
+                recorder.addFrame( milliseconds( 10 ));
+                recorder.addBytesLoaded( 1 );
+            }
+        });
+    }
+
+    uint64_t frames = 0;
+    for( size_t i = 0; i < 10; ++i )
+        frames += collector.collect().getFrames();
+    for( auto& thread : threads )
+        thread.join();
+    frames += collector.collect().getFrames();
+    BOOST_CHECK_EQUAL( frames, nThreads * nFrames );
+}
+
+BOOST_AUTO_TEST_CASE( publish )
+{
+    TelemetryCollector collector;
+    collector.createRecorder().addFrame( milliseconds( 10 ));
+
+    std::atomic< uint64_t > frames{ 0 };
+    std::atomic< size_t > published{ 0 };
+    collector.startPublishing( [&]( const servus::Serializable& event )
+    {
+        frames += static_cast< const Telemetry& >( event ).getFrames();
+        ++published;
+        return true;
+    }, milliseconds( 1 ));
+
+    while( published < 3 )
+        std::this_thread::sleep_for( milliseconds( 1 ));
+    collector.stopPublishing();
+
+    // periods start with publishing, earlier data is not published
+    BOOST_CHECK_EQUAL( frames, 0 );
+}
+
+BOOST_AUTO_TEST_CASE( exitedThreads )
+{
+    TelemetryCollector collector;
+    const size_t nThreads = 100;
+
+    // short-lived threads leave their data, but not their recorders behind
+    for( size_t i = 0; i < nThreads; ++i )
+    {
+        std::thread thread( [&]
+            { collector.createRecorder().addFrame( milliseconds( 10 )); });
+        thread.join();
+    }
+    BOOST_CHECK_EQUAL( collector.getNumRecorders(), 0 );
+    BOOST_CHECK_EQUAL( collector.collect().getFrames(), nThreads );
+    BOOST_CHECK_EQUAL( collector.collect().getFrames(), 0 );
+
+    // threads may outlive the collector
+    std::atomic< bool > created{ false };
+    std::atomic< bool > destroyed{ false };
+    std::thread outliving;
+    {
+        TelemetryCollector shortLived;
+        outliving = std::thread( [&]
+        {
+            shortLived.createRecorder().addFrame( milliseconds( 10 ));
+            created = true;
+            while( !destroyed )
+                std::this_thread::sleep_for( milliseconds( 1 ));
+        });
+        while( !created )
+            std::this_thread::sleep_for( milliseconds( 1 ));
+        BOOST_CHECK_EQUAL( shortLived.getNumRecorders(), 1 );
+    }
+    destroyed = true;
+    outliving.join();
+}
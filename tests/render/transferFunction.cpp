@@ -0,0 +1,73 @@
+/* Copyright (c) 2018, Human Brain Project
+ *                     bbp-open-source@googlegroups.com
+ */
+
+#define BOOST_TEST_MODULE TransferFunction
+
+#include <lexis/render/TransferFunction.h>
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+
+using lexis::render::TransferFunction;
+using lexis::render::detail::Channel;
+using lexis::render::detail::ControlPoint;
+using lexis::render::detail::ControlPointType;
+
+BOOST_AUTO_TEST_CASE( evaluate )
+{
+    TransferFunction tf;
+    BOOST_CHECK_EQUAL( tf.evaluate( Channel::Alpha, 0.5f ), 0.f );
+
+    tf.setPoints( {
+        { Channel::Alpha, ControlPointType::Linear, 0.75f, 1.f, 0.f },
+        { Channel::Alpha, ControlPointType::Linear, 0.25f, 0.f, 0.f },
+        { Channel::DiffuseRed, ControlPointType::Gaussian, 0.5f, 0.5f, 0.1f },
+        { Channel::DiffuseRed, ControlPointType::Gaussian, 0.5f, 0.75f, 0.1f }
+    });
+
+    BOOST_CHECK_EQUAL( tf.evaluate( Channel::Alpha, 0.f ), 0.f );
+    BOOST_CHECK_EQUAL( tf.evaluate( Channel::Alpha, 0.5f ), 0.5f );
+    BOOST_CHECK_EQUAL( tf.evaluate( Channel::Alpha, 1.f ), 1.f );
+
+    // sum of both Gaussians is clamped at the center
+    BOOST_CHECK_EQUAL( tf.evaluate( Channel::DiffuseRed, 0.5f ), 1.f );
+    BOOST_CHECK_CLOSE( tf.evaluate( Channel::DiffuseRed, 0.6f ),
+                       1.25f * std::exp( -0.5f ), 0.001f );
+    BOOST_CHECK_EQUAL( tf.evaluate( Channel::DiffuseGreen, 0.5f ), 0.f );
+}
+
+BOOST_AUTO_TEST_CASE( materialLUT )
+{
+    TransferFunction tf;
+    double range[] = { -1.0, 1.0 };
+    tf.setRange( range );
+    tf.setPoints( {
+        { Channel::Alpha, ControlPointType::Linear, 0.f, 0.f, 0.f },
+        { Channel::Alpha, ControlPointType::Linear, 1.f, 1.f, 0.f },
+        { Channel::DiffuseGreen, ControlPointType::Linear, 0.f, 0.5f, 0.f }
+    });
+
+    const auto& lut = tf.getMaterialLUT( 5 );
+    BOOST_CHECK_EQUAL( lut.getRange()[0], -1.0 );
+    BOOST_CHECK_EQUAL( lut.getRange()[1], 1.0 );
+    BOOST_CHECK( lut.getEmission().empty( ));
+    BOOST_CHECK( lut.getContribution().empty( ));
+
+    BOOST_REQUIRE_EQUAL( lut.getAlpha().size(), 5 );
+    BOOST_CHECK_EQUAL( lut.getAlpha()[2], 0.5f );
+    BOOST_REQUIRE_EQUAL( lut.getDiffuse().size(), 5 );
+    for( const auto& color : lut.getDiffuse( ))
+    {
+        BOOST_CHECK_EQUAL( color.getRed(), 0.f );
+        BOOST_CHECK_EQUAL( color.getGreen(), 0.5f );
+    }
+
+    // cached until the control points or the size change
+    BOOST_CHECK_EQUAL( &tf.getMaterialLUT( 5 ), &lut );
+    BOOST_CHECK_EQUAL( tf.getMaterialLUT( 5 ).getAlpha().size(), 5 );
+    BOOST_CHECK_EQUAL( tf.getMaterialLUT( 64 ).getAlpha().size(), 64 );
+
+    tf.getPoints().clear();
+    BOOST_CHECK( tf.getMaterialLUT( 64 ).getAlpha().empty( ));
+}